@@ -0,0 +1,126 @@
+# zvmone: Fast Zond Virtual Machine implementation
+# Copyright 2026 The evmone Authors.
+# SPDX-License-Identifier: Apache-2.0
+
+# Profile-guided optimization (PGO) of the zvmone library.
+#
+# The profile is collected and used in the same build directory:
+#
+#   cmake -S . -B build -DZVMONE_TESTING=ON -DZVMONE_PGO=generate
+#   cmake --build build --target zvmone-pgo-train
+#   cmake -S . -B build -DZVMONE_TESTING=ON -DZVMONE_PGO=use
+#   cmake --build build
+#
+# With ZVMONE_PGO=generate the library is instrumented and the zvmone-pgo-train target runs
+# zvmone-bench collecting the profile in ZVMONE_PGO_DIR. With ZVMONE_PGO=use the library
+# is rebuilt using the collected profile. If llvm-bolt is found, the zvmone-bolt target
+# additionally optimizes the code layout of the linked shared library; the result is placed
+# in the bolt subdirectory of ZVMONE_PGO_DIR.
+
+if(NOT ZVMONE_PGO)
+    return()
+endif()
+
+if(NOT CABLE_COMPILER_GNULIKE)
+    message(FATAL_ERROR "ZVMONE_PGO requires GCC or Clang compiler")
+endif()
+
+if(CABLE_COMPILER_CLANG)
+    string(REGEX MATCH "^[0-9]+" clang_major_version ${CMAKE_CXX_COMPILER_VERSION})
+    find_program(ZVMONE_LLVM_PROFDATA NAMES llvm-profdata-${clang_major_version} llvm-profdata)
+    if(NOT ZVMONE_LLVM_PROFDATA)
+        message(FATAL_ERROR "ZVMONE_PGO with Clang requires llvm-profdata")
+    endif()
+endif()
+find_program(ZVMONE_LLVM_BOLT NAMES llvm-bolt)
+
+# The merged Clang profile.
+set(zvmone_pgo_profdata ${ZVMONE_PGO_DIR}/zvmone.profdata)
+
+# Instruments the TARGET library or optimizes it with the collected profile.
+function(zvmone_configure_pgo TARGET)
+    if(ZVMONE_PGO STREQUAL generate)
+        if(CABLE_COMPILER_CLANG)
+            set(flags -fprofile-generate)
+        else()
+            set(flags -fprofile-generate=${ZVMONE_PGO_DIR})
+        endif()
+        target_compile_options(${TARGET} PRIVATE ${flags})
+        target_link_options(${TARGET} PRIVATE ${flags})
+    else()
+        if(CABLE_COMPILER_CLANG)
+            if(NOT EXISTS ${zvmone_pgo_profdata})
+                message(FATAL_ERROR "ZVMONE_PGO profile not found: ${zvmone_pgo_profdata}")
+            endif()
+            target_compile_options(${TARGET} PRIVATE
+                -fprofile-use=${zvmone_pgo_profdata} -Wno-profile-instr-unprofiled)
+        else()
+            if(NOT EXISTS ${ZVMONE_PGO_DIR})
+                message(FATAL_ERROR "ZVMONE_PGO profile not found: ${ZVMONE_PGO_DIR}")
+            endif()
+            # The partial training keeps the code not executed by the benchmarks optimized
+            # for speed instead of size.
+            target_compile_options(${TARGET} PRIVATE
+                -fprofile-use=${ZVMONE_PGO_DIR} -fprofile-partial-training -Wno-missing-profile
+                -Wno-error=coverage-mismatch)
+        endif()
+
+        get_target_property(type ${TARGET} TYPE)
+        if(ZVMONE_LLVM_BOLT AND type STREQUAL SHARED_LIBRARY AND CMAKE_SYSTEM_NAME STREQUAL Linux)
+            # BOLT needs the relocations to reorder the functions.
+            target_link_options(${TARGET} PRIVATE LINKER:--emit-relocs)
+        endif()
+    endif()
+endfunction()
+
+# Adds the targets collecting the profile of the TARGET library by running the BENCH executable
+# with the arguments ARGN.
+function(zvmone_add_pgo_targets TARGET BENCH)
+    if(ZVMONE_PGO STREQUAL generate)
+        if(CABLE_COMPILER_CLANG)
+            set(profraw ${ZVMONE_PGO_DIR}/zvmone.profraw)
+            set(profile_env LLVM_PROFILE_FILE=${profraw})
+            set(merge_command
+                COMMAND ${ZVMONE_LLVM_PROFDATA} merge -output=${zvmone_pgo_profdata} ${profraw})
+        endif()
+
+        add_custom_target(
+            zvmone-pgo-train
+            # Drop the stale profile: GCC accumulates the counters of all runs.
+            COMMAND ${CMAKE_COMMAND} -E rm -rf ${ZVMONE_PGO_DIR}
+            COMMAND ${CMAKE_COMMAND} -E make_directory ${ZVMONE_PGO_DIR}
+            COMMAND ${CMAKE_COMMAND} -E env ${profile_env} $<TARGET_FILE:${BENCH}> ${ARGN}
+            ${merge_command}
+            DEPENDS ${TARGET} ${BENCH}
+            COMMENT "Collecting the ${TARGET} profile in ${ZVMONE_PGO_DIR}"
+            USES_TERMINAL
+            VERBATIM
+        )
+        return()
+    endif()
+
+    get_target_property(type ${TARGET} TYPE)
+    if(NOT ZVMONE_LLVM_BOLT OR NOT type STREQUAL SHARED_LIBRARY OR NOT CMAKE_SYSTEM_NAME STREQUAL Linux)
+        return()
+    endif()
+
+    set(bolt_dir ${ZVMONE_PGO_DIR}/bolt)
+    set(instrumented ${bolt_dir}/instrumented/$<TARGET_SONAME_FILE_NAME:${TARGET}>)
+    set(fdata ${bolt_dir}/${TARGET}.fdata)
+
+    add_custom_target(
+        zvmone-bolt
+        COMMAND ${CMAKE_COMMAND} -E make_directory ${bolt_dir}/instrumented
+        COMMAND ${ZVMONE_LLVM_BOLT} $<TARGET_FILE:${TARGET}> -instrument
+            -instrumentation-file=${fdata} -o ${instrumented}
+        # The preloaded instrumented library replaces the one the benchmark is linked with.
+        COMMAND ${CMAKE_COMMAND} -E env LD_PRELOAD=${instrumented} $<TARGET_FILE:${BENCH}> ${ARGN}
+        COMMAND ${ZVMONE_LLVM_BOLT} $<TARGET_FILE:${TARGET}> -data=${fdata}
+            -reorder-blocks=ext-tsp -reorder-functions=hfsort -split-functions -split-all-cold
+            -icf=1 -o ${bolt_dir}/$<TARGET_FILE_NAME:${TARGET}>
+        DEPENDS ${TARGET} ${BENCH}
+        COMMENT "Optimizing the ${TARGET} code layout with BOLT in ${bolt_dir}"
+        USES_TERMINAL
+        VERBATIM
+    )
+endfunction()
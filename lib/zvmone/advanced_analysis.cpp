@@ -39,23 +39,171 @@ struct BlockAnalysis
     }
 };
 
-AdvancedCodeAnalysis analyze(zvmc_revision rev, bytes_view code) noexcept
+AnalysisSizes count_instructions(bytes_view code) noexcept
 {
-    const auto& op_tbl = get_op_table(rev);
-    const auto opx_beginblock_fn = op_tbl[OPX_BEGINBLOCK].fn;
+    AnalysisSizes sizes;
+    for (size_t i = 0; i < code.size(); ++i)
+    {
+        const auto op = code[i];
+        ++sizes.num_instrs;
+        if (op >= OP_PUSH1 && op <= OP_PUSH32)
+        {
+            sizes.num_large_pushes += (op >= OP_PUSH9);
+            i += static_cast<size_t>(op - OP_PUSH1) + 1;  // Skip PUSH data.
+        }
+    }
+    return sizes;
+}
 
-    AdvancedCodeAnalysis analysis;
+namespace
+{
+/// The builder of the analysis of the given type used by analyze_code().
+///
+/// The builder defines the encoding of the instructions: the type of the instruction argument,
+/// where the block requirements are stored and where the arguments not fitting the instruction
+/// are placed.
+template <typename AnalysisT>
+struct Builder;
+
+template <>
+struct Builder<AdvancedCodeAnalysis>
+{
+    using Arg = InstructionArgument;
+
+    AdvancedCodeAnalysis& analysis;
+    const OpTable& op_tbl;
+
+    /// The indexes of the PUSH instructions followed by JUMP/JUMPI. These are replaced
+    /// with direct jumps once all jump destinations are known.
+    std::vector<size_t> static_jumps;
+
+    uint8_t prev_opcode = OP_JUMPDEST;  // Anything except PUSH.
+
+    /// Returns the index of the instruction starting the new block.
+    /// The block information is placed in the argument of this instruction.
+    [[nodiscard]] size_t new_block() const noexcept { return analysis.instrs.size(); }
+
+    void close_block(const BlockAnalysis& block) noexcept
+    {
+        analysis.instrs[block.begin_block_index].arg.block = block.close();
+    }
+
+    [[nodiscard]] static Arg block_arg(const BlockAnalysis& /*block*/) noexcept
+    {
+        return {};  // Set in close_block().
+    }
+
+    [[nodiscard]] static Arg small_push_arg(uint64_t value, size_t /*push_size*/) noexcept
+    {
+        Arg arg;
+        arg.small_push_value = value;
+        return arg;
+    }
+
+    [[nodiscard]] static Arg push_value_arg(const intx::uint256& push_value) noexcept
+    {
+        Arg arg;
+        arg.push_value = &push_value;
+        return arg;
+    }
+
+    [[nodiscard]] static Arg number_arg(int64_t number) noexcept
+    {
+        Arg arg;
+        arg.number = number;
+        return arg;
+    }
+
+    [[nodiscard]] static Arg pc_arg(size_t pc) noexcept
+    {
+        return number_arg(static_cast<int64_t>(pc));
+    }
+
+    void emit(uint8_t opcode, Arg arg) noexcept
+    {
+        // The destination pushed by the preceding small PUSH is a constant.
+        if ((opcode == OP_JUMP || opcode == OP_JUMPI) && prev_opcode >= OP_PUSH1 &&
+            prev_opcode <= OP_PUSH8)
+            static_jumps.emplace_back(analysis.instrs.size() - 1);
+        prev_opcode = opcode;
+
+        analysis.instrs.emplace_back(op_tbl[opcode].fn).arg = arg;
+    }
+};
+
+template <>
+struct Builder<CompactCodeAnalysis>
+{
+    using Arg = size_t;
+
+    CompactCodeAnalysis& analysis;
+    const OpTable& op_tbl;
+
+    /// Returns the index of the new block in CompactCodeAnalysis::blocks.
+    [[nodiscard]] size_t new_block() noexcept
+    {
+        const auto index = analysis.blocks.size();
+        analysis.blocks.emplace_back();
+        return index;
+    }
+
+    void close_block(const BlockAnalysis& block) noexcept
+    {
+        analysis.blocks[block.begin_block_index] = block.close();
+    }
+
+    [[nodiscard]] static Arg block_arg(const BlockAnalysis& block) noexcept
+    {
+        return block.begin_block_index;
+    }
+
+    [[nodiscard]] Arg small_push_arg(uint64_t value, size_t push_size) noexcept
+    {
+        if (push_size <= 3)
+            return static_cast<size_t>(value);  // The PUSH1-PUSH3 value fits the argument.
+
+        analysis.small_push_values.emplace_back(value);
+        return analysis.small_push_values.size() - 1;
+    }
+
+    [[nodiscard]] Arg push_value_arg(const intx::uint256& /*push_value*/) const noexcept
+    {
+        return analysis.push_values.size() - 1;
+    }
+
+    [[nodiscard]] Arg number_arg(int64_t number) noexcept
+    {
+        analysis.numbers.emplace_back(number);
+        return analysis.numbers.size() - 1;
+    }
+
+    [[nodiscard]] static Arg pc_arg(size_t pc) noexcept { return pc; }
+
+    void emit(uint8_t opcode, Arg arg) noexcept
+    {
+        analysis.instrs.emplace_back(opcode, static_cast<uint32_t>(arg));
+    }
+};
+
+/// Analyzes the code producing the instructions and the basic blocks with the builder.
+template <typename AnalysisT>
+void analyze_code(Builder<AnalysisT>& builder, bytes_view code) noexcept
+{
+    auto& analysis = builder.analysis;
+    const auto& op_tbl = builder.op_tbl;
 
-    const auto max_instrs_size = code.size() + 2;  // Additional OPX_BEGINBLOCK and STOP
+    const auto sizes = count_instructions(code);
+
+    const auto max_instrs_size = sizes.num_instrs + 2;  // Additional OPX_BEGINBLOCK and STOP
     analysis.instrs.reserve(max_instrs_size);
 
-    // This is 2x more than needed but using (code.size() / 2 + 1) increases page-faults 1000x.
-    const auto max_args_storage_size = code.size() + 1;
+    // The push values are referenced by pointers so the storage must not be reallocated.
+    const auto max_args_storage_size = sizes.num_large_pushes;
     analysis.push_values.reserve(max_args_storage_size);
 
     // Create first block.
-    analysis.instrs.emplace_back(opx_beginblock_fn);
-    auto block = BlockAnalysis{0};
+    auto block = BlockAnalysis{builder.new_block()};
+    builder.emit(OPX_BEGINBLOCK, builder.block_arg(block));
 
     // TODO: Iterators are not used here because because push_end may point way outside of code
     //       and this is not allowed and MSVC will detect it with instrumented iterators.
@@ -66,29 +214,27 @@ AdvancedCodeAnalysis analyze(zvmc_revision rev, bytes_view code) noexcept
     {
         const auto opcode = *code_pos++;
         const auto& opcode_info = op_tbl[opcode];
+        typename Builder<AnalysisT>::Arg arg{};
 
         if (opcode == OP_JUMPDEST)
         {
             // Save current block.
-            analysis.instrs[block.begin_block_index].arg.block = block.close();
+            builder.close_block(block);
             // Create new block.
-            block = BlockAnalysis{analysis.instrs.size()};
+            block = BlockAnalysis{builder.new_block()};
+            arg = builder.block_arg(block);
 
             // The JUMPDEST is always the first instruction in the block.
             analysis.jumpdest_offsets.emplace_back(static_cast<int32_t>(code_pos - code_begin - 1));
             analysis.jumpdest_targets.emplace_back(static_cast<int32_t>(analysis.instrs.size()));
         }
 
-        analysis.instrs.emplace_back(opcode_info.fn);
-
         block.stack_req = std::max(block.stack_req, opcode_info.stack_req - block.stack_change);
         block.stack_change += opcode_info.stack_change;
         block.stack_max_growth = std::max(block.stack_max_growth, block.stack_change);
 
         block.gas_cost += opcode_info.gas_cost;
 
-        auto& instr = analysis.instrs.back();
-
         switch (opcode)
         {
         default:
@@ -117,9 +263,10 @@ AdvancedCodeAnalysis analyze(zvmc_revision rev, bytes_view code) noexcept
             // and hold metadata for the next block.
 
             // Save current block.
-            analysis.instrs[block.begin_block_index].arg.block = block.close();
+            builder.close_block(block);
             // Create new block.
-            block = BlockAnalysis{analysis.instrs.size() - 1};
+            block = BlockAnalysis{builder.new_block()};
+            arg = builder.block_arg(block);
             break;
 
         case ANY_SMALL_PUSH:
@@ -134,7 +281,7 @@ AdvancedCodeAnalysis analyze(zvmc_revision rev, bytes_view code) noexcept
                 value |= uint64_t{*code_pos++} << insert_bit_pos;
                 insert_bit_pos -= 8;
             }
-            instr.arg.small_push_value = value;
+            arg = builder.small_push_arg(value, push_size);
             break;
         }
 
@@ -159,7 +306,7 @@ AdvancedCodeAnalysis analyze(zvmc_revision rev, bytes_view code) noexcept
             while (code_pos < push_end && code_pos < code_end)
                 *insert_pos-- = *code_pos++;
 
-            instr.arg.push_value = &push_value;
+            arg = builder.push_value_arg(push_value);
             break;
         }
 
@@ -170,28 +317,70 @@ AdvancedCodeAnalysis analyze(zvmc_revision rev, bytes_view code) noexcept
         case OP_CREATE:
         case OP_CREATE2:
         case OP_SSTORE:
-            instr.arg.number = block.gas_cost;
+            arg = builder.number_arg(block.gas_cost);
             break;
 
         case OP_PC:
-            instr.arg.number = code_pos - code_begin - 1;
+            arg = builder.pc_arg(static_cast<size_t>(code_pos - code_begin - 1));
             break;
         }
+
+        builder.emit(opcode, arg);
     }
 
     // Save current block.
-    analysis.instrs[block.begin_block_index].arg.block = block.close();
+    builder.close_block(block);
 
     // Make sure the last block is terminated.
     // TODO: This is not needed if the last instruction is a terminating one.
-    analysis.instrs.emplace_back(op_tbl[OP_STOP].fn);
+    builder.emit(OP_STOP, {});
 
     assert(analysis.instrs.size() <= max_instrs_size);
 
     // Make sure the push_values has not been reallocated. Otherwise iterators are invalid.
     assert(analysis.push_values.size() <= max_args_storage_size);
+}
+}  // namespace
+
+AdvancedCodeAnalysis analyze(zvmc_revision rev, bytes_view code) noexcept
+{
+    AdvancedCodeAnalysis analysis;
+    Builder<AdvancedCodeAnalysis> builder{analysis, get_op_table(rev), {}};
+    analyze_code(builder, code);
+
+    if (code.size() <= max_dense_jumpdest_map_code_size)
+    {
+        analysis.jumpdest_map.assign(code.size(), -1);
+        for (size_t i = 0; i < analysis.jumpdest_offsets.size(); ++i)
+        {
+            analysis.jumpdest_map[static_cast<size_t>(analysis.jumpdest_offsets[i])] =
+                analysis.jumpdest_targets[i];
+        }
+    }
+
+    // Replace the PUSH+JUMP(I) pairs with direct jumps to already validated targets.
+    const auto jump_fn = builder.op_tbl[OP_JUMP].fn;
+    for (const auto push_index : builder.static_jumps)
+    {
+        auto& push_instr = analysis.instrs[push_index];
+        const auto dst = push_instr.arg.small_push_value;
+        const auto conditional = analysis.instrs[push_index + 1].fn != jump_fn;
+        push_instr.fn = get_static_jump_fn(conditional);
+        push_instr.arg.number = dst <= static_cast<uint64_t>(std::numeric_limits<int>::max()) ?
+                                    find_jumpdest(analysis, static_cast<int>(dst)) :
+                                    -1;
+    }
 
     return analysis;
 }
 
+CompactCodeAnalysis analyze_compact(zvmc_revision rev, bytes_view code) noexcept
+{
+    assert(code.size() <= CompactCodeAnalysis::max_code_size);
+
+    CompactCodeAnalysis analysis;
+    Builder<CompactCodeAnalysis> builder{analysis, get_op_table(rev)};
+    analyze_code(builder, code);
+    return analysis;
+}
 }  // namespace zvmone::advanced
@@ -8,6 +8,7 @@
 #include <intx/intx.hpp>
 #include <zvmc/utils.h>
 #include <zvmc/zvmc.hpp>
+#include <algorithm>
 #include <array>
 #include <cstdint>
 #include <vector>
@@ -99,7 +100,8 @@ struct AdvancedExecutionState : ExecutionState
     {}
 
     /// Terminates the execution with the given status code.
-    const Instruction* exit(zvmc_status_code status_code) noexcept
+    template <typename InstructionT = Instruction>
+    const InstructionT* exit(zvmc_status_code status_code) noexcept
     {
         status = status_code;
         return nullptr;
@@ -131,6 +133,12 @@ static_assert(
 /// The pointer to function implementing an instruction execution.
 using instruction_exec_fn = const Instruction* (*)(const Instruction*, AdvancedExecutionState&);
 
+struct CompactInstruction;
+
+/// The pointer to function implementing a compact instruction execution.
+using compact_instruction_exec_fn = const CompactInstruction* (*)(
+    const CompactInstruction*, AdvancedExecutionState&);
+
 /// The zvmone intrinsic opcodes.
 ///
 /// These intrinsic instructions may be injected to the code in the analysis phase.
@@ -179,9 +187,94 @@ struct AdvancedCodeAnalysis
     /// matching the elements from jumdest_offsets.
     /// This is value to which the next instruction pointer must be set in JUMP/JUMPI.
     std::vector<int32_t> jumpdest_targets;
+
+    /// The dense map of jump destinations indexed by the code offset.
+    /// The element is the index of the target instruction or -1 if the offset is not a JUMPDEST.
+    /// Built only for the code not larger than max_dense_jumpdest_map_code_size,
+    /// otherwise empty and the jumpdest_offsets are searched.
+    std::vector<int32_t> jumpdest_map;
 };
 
+/// The maximum code size for which the dense jumpdest map is built.
+/// The map takes 4 bytes per code byte, i.e. 96 KiB for the code of this size.
+constexpr size_t max_dense_jumpdest_map_code_size = 0x6000;
+
 inline int find_jumpdest(const AdvancedCodeAnalysis& analysis, int offset) noexcept
+{
+    if (!analysis.jumpdest_map.empty())
+    {
+        const auto index = static_cast<size_t>(offset);
+        return index < analysis.jumpdest_map.size() ? analysis.jumpdest_map[index] : -1;
+    }
+
+    const auto begin = std::begin(analysis.jumpdest_offsets);
+    const auto end = std::end(analysis.jumpdest_offsets);
+    const auto it = std::lower_bound(begin, end, offset);
+    return (it != end && *it == offset) ?
+               analysis.jumpdest_targets[static_cast<size_t>(it - begin)] :
+               -1;
+}
+
+/// The compact 32-bit instruction: the opcode in the lowest 8 bits
+/// and the 24-bit argument in the remaining bits.
+///
+/// The argument is interpreted depending on the opcode:
+/// - JUMPDEST (OPX_BEGINBLOCK) and JUMPI: the index of the block in CompactCodeAnalysis::blocks,
+/// - PUSH1-PUSH3: the push value,
+/// - PUSH4-PUSH8: the index in CompactCodeAnalysis::small_push_values,
+/// - PUSH9-PUSH32: the index in CompactCodeAnalysis::push_values,
+/// - GAS, SSTORE, calls and creates: the index in CompactCodeAnalysis::numbers
+///   of the gas cost of the block up to the instruction,
+/// - PC: the code offset.
+struct CompactInstruction
+{
+    /// The maximum value of the argument.
+    static constexpr uint32_t max_arg = (uint32_t{1} << 24) - 1;
+
+    uint32_t bits = 0;
+
+    explicit constexpr CompactInstruction(uint8_t opcode, uint32_t arg = 0) noexcept
+      : bits{opcode | (arg << 8)}
+    {}
+
+    [[nodiscard]] constexpr uint8_t opcode() const noexcept { return static_cast<uint8_t>(bits); }
+
+    [[nodiscard]] constexpr uint32_t arg() const noexcept { return bits >> 8; }
+};
+static_assert(sizeof(CompactInstruction) == sizeof(uint32_t));
+
+using CompactOpTable = std::array<compact_instruction_exec_fn, 256>;
+
+/// The Advanced code analysis with the compact instruction encoding.
+///
+/// Takes about 4x less memory than AdvancedCodeAnalysis. The instruction arguments
+/// not fitting 24 bits are placed in the side tables and referenced by index.
+struct CompactCodeAnalysis
+{
+    /// The maximum code size for which the instruction arguments fit in 24 bits.
+    static constexpr size_t max_code_size = CompactInstruction::max_arg - 2;
+
+    std::vector<CompactInstruction> instrs;
+
+    /// The requirements of the basic blocks.
+    std::vector<BlockInfo> blocks;
+
+    /// The values of PUSH4-PUSH8.
+    std::vector<uint64_t> small_push_values;
+
+    /// The values of PUSH9-PUSH32.
+    std::vector<intx::uint256> push_values;
+
+    /// The gas costs of the blocks up to the instructions inspecting the gas left.
+    std::vector<int64_t> numbers;
+
+    /// The sorted offsets of JUMPDESTs in the original code
+    /// and the indexes of the matching instructions.
+    std::vector<int32_t> jumpdest_offsets;
+    std::vector<int32_t> jumpdest_targets;
+};
+
+inline int find_jumpdest(const CompactCodeAnalysis& analysis, int offset) noexcept
 {
     const auto begin = std::begin(analysis.jumpdest_offsets);
     const auto end = std::end(analysis.jumpdest_offsets);
@@ -191,8 +284,37 @@ inline int find_jumpdest(const AdvancedCodeAnalysis& analysis, int offset) noexc
                -1;
 }
 
+/// The upper bounds of the sizes of the analysis storage.
+struct AnalysisSizes
+{
+    size_t num_instrs = 0;
+    size_t num_large_pushes = 0;
+};
+
+/// Counts the instructions and the PUSH9-PUSH32 instructions in the code.
+///
+/// The counts include the dead code instructions skipped by the analysis so they are upper bounds.
+/// The analysis reserves the storage for them so it is never reallocated and the pointers
+/// to the push values remain valid.
+ZVMC_EXPORT AnalysisSizes count_instructions(bytes_view code) noexcept;
+
 ZVMC_EXPORT AdvancedCodeAnalysis analyze(zvmc_revision rev, bytes_view code) noexcept;
 
+/// Analyzes the code producing the compact instructions.
+/// The code size must not exceed CompactCodeAnalysis::max_code_size.
+ZVMC_EXPORT CompactCodeAnalysis analyze_compact(zvmc_revision rev, bytes_view code) noexcept;
+
+ZVMC_EXPORT const CompactOpTable& get_compact_op_table(zvmc_revision rev) noexcept;
+
 ZVMC_EXPORT const OpTable& get_op_table(zvmc_revision rev) noexcept;
 
+/// Returns the implementation of the direct jump replacing the PUSH instruction
+/// followed by JUMP (or by JUMPI if conditional is true).
+///
+/// The argument of the direct jump is the index of the target instruction
+/// or -1 if the pushed destination is not a valid JUMPDEST. The following JUMP/JUMPI
+/// instruction remains in place: it is never executed but the JUMPI keeps the requirements
+/// of the block following it.
+ZVMC_EXPORT instruction_exec_fn get_static_jump_fn(bool conditional) noexcept;
+
 }  // namespace zvmone::advanced
@@ -4,7 +4,7 @@
 
 #include "advanced_execution.hpp"
 #include "advanced_analysis.hpp"
-#include <memory>
+#include "execution_state_pool.hpp"
 
 namespace zvmone::advanced
 {
@@ -25,13 +25,51 @@ zvmc_result execute(AdvancedExecutionState& state, const AdvancedCodeAnalysis& a
         state.memory.data() + state.output_offset, state.output_size);
 }
 
+zvmc_result execute(AdvancedExecutionState& state, const CompactCodeAnalysis& analysis) noexcept
+{
+    state.analysis.advanced_compact = &analysis;  // Allow accessing the analysis by instructions.
+
+    const auto& op_table = get_compact_op_table(state.rev);
+    const auto* instr = analysis.instrs.data();  // Get the first instruction.
+    while (instr != nullptr)
+        instr = op_table[instr->opcode()](instr, state);
+
+    const auto gas_left =
+        (state.status == ZVMC_SUCCESS || state.status == ZVMC_REVERT) ? state.gas_left : 0;
+    const auto gas_refund = (state.status == ZVMC_SUCCESS) ? state.gas_refund : 0;
+
+    assert(state.output_size != 0 || state.output_offset == 0);
+    return zvmc::make_result(state.status, gas_left, gas_refund,
+        state.memory.data() + state.output_offset, state.output_size);
+}
+
+zvmc_result execute(const AdvancedCodeAnalysis& analysis, const zvmc_host_interface* host,
+    zvmc_host_context* ctx, zvmc_revision rev, const zvmc_message* msg, bytes_view code) noexcept
+{
+    thread_local ExecutionStatePool<AdvancedExecutionState> state_pool;
+    const auto state = state_pool.acquire(*msg, rev, *host, ctx, code);
+    return execute(*state, analysis);
+}
+
 zvmc_result execute(zvmc_vm* /*unused*/, const zvmc_host_interface* host, zvmc_host_context* ctx,
     zvmc_revision rev, const zvmc_message* msg, const uint8_t* code, size_t code_size) noexcept
 {
     AdvancedCodeAnalysis analysis;
     const bytes_view container = {code, code_size};
     analysis = analyze(rev, container);
-    auto state = std::make_unique<AdvancedExecutionState>(*msg, rev, *host, ctx, container);
+    return execute(analysis, host, ctx, rev, msg, container);
+}
+
+zvmc_result execute_compact(zvmc_vm* vm, const zvmc_host_interface* host, zvmc_host_context* ctx,
+    zvmc_revision rev, const zvmc_message* msg, const uint8_t* code, size_t code_size) noexcept
+{
+    if (code_size > CompactCodeAnalysis::max_code_size)
+        return execute(vm, host, ctx, rev, msg, code, code_size);
+
+    const bytes_view container = {code, code_size};
+    const auto analysis = analyze_compact(rev, container);
+    thread_local ExecutionStatePool<AdvancedExecutionState> state_pool;
+    const auto state = state_pool.acquire(*msg, rev, *host, ctx, container);
     return execute(*state, analysis);
 }
 }  // namespace zvmone::advanced
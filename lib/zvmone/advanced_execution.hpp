@@ -5,17 +5,33 @@
 
 #include <zvmc/utils.h>
 #include <zvmc/zvmc.h>
+#include <string_view>
 
 namespace zvmone::advanced
 {
 struct AdvancedExecutionState;
 struct AdvancedCodeAnalysis;
+struct CompactCodeAnalysis;
 
 /// Execute the already analyzed code using the provided execution state.
 ZVMC_EXPORT zvmc_result execute(
     AdvancedExecutionState& state, const AdvancedCodeAnalysis& analysis) noexcept;
 
+/// Execute the code analyzed into the compact instructions using the provided execution state.
+ZVMC_EXPORT zvmc_result execute(
+    AdvancedExecutionState& state, const CompactCodeAnalysis& analysis) noexcept;
+
+/// Execute the already analyzed code using the ZVMC execution parameters.
+zvmc_result execute(const AdvancedCodeAnalysis& analysis, const zvmc_host_interface* host,
+    zvmc_host_context* ctx, zvmc_revision rev, const zvmc_message* msg,
+    std::basic_string_view<uint8_t> code) noexcept;
+
 /// ZVMC-compatible execute() function.
 zvmc_result execute(zvmc_vm* vm, const zvmc_host_interface* host, zvmc_host_context* ctx,
     zvmc_revision rev, const zvmc_message* msg, const uint8_t* code, size_t code_size) noexcept;
+
+/// ZVMC-compatible execute() function using the compact instructions.
+/// The code too large for the compact instructions is executed with the regular ones.
+zvmc_result execute_compact(zvmc_vm* vm, const zvmc_host_interface* host, zvmc_host_context* ctx,
+    zvmc_revision rev, const zvmc_message* msg, const uint8_t* code, size_t code_size) noexcept;
 }  // namespace zvmone::advanced
@@ -76,37 +76,39 @@ inline code_iterator impl(AdvancedExecutionState& state, code_iterator pos) noex
 /// Fake wrap for generic instruction implementations accessing current code location.
 /// This is to make any op<...> compile, but pointers must be replaced with Advanced-specific
 /// implementation. Definition not provided.
-template <code_iterator InstrFn(AdvancedExecutionState&, code_iterator)>
-const Instruction* op(const Instruction* /*instr*/, AdvancedExecutionState& state) noexcept;
+template <code_iterator InstrFn(AdvancedExecutionState&, code_iterator),
+    typename InstructionT = Instruction>
+const InstructionT* op(const InstructionT* /*instr*/, AdvancedExecutionState& state) noexcept;
 
 namespace
 {
 using advanced::op;
 
 /// Wraps the generic instruction implementation to advanced instruction function signature.
-template <void InstrFn(AdvancedExecutionState&) noexcept>
-const Instruction* op(const Instruction* instr, AdvancedExecutionState& state) noexcept
+template <void InstrFn(AdvancedExecutionState&) noexcept, typename InstructionT = Instruction>
+const InstructionT* op(const InstructionT* instr, AdvancedExecutionState& state) noexcept
 {
     InstrFn(state);
     return ++instr;
 }
 
 /// Wraps the generic instruction implementation to advanced instruction function signature.
-template <zvmc_status_code InstrFn(AdvancedExecutionState&) noexcept>
-const Instruction* op(const Instruction* instr, AdvancedExecutionState& state) noexcept
+template <zvmc_status_code InstrFn(AdvancedExecutionState&) noexcept,
+    typename InstructionT = Instruction>
+const InstructionT* op(const InstructionT* instr, AdvancedExecutionState& state) noexcept
 {
     if (const auto status_code = InstrFn(state); status_code != ZVMC_SUCCESS)
-        return state.exit(status_code);
+        return state.exit<InstructionT>(status_code);
     return ++instr;
 }
 
 /// Wraps the generic instruction implementation to advanced instruction function signature.
-template <TermResult InstrFn(AdvancedExecutionState&) noexcept>
-const Instruction* op(const Instruction* /*instr*/, AdvancedExecutionState& state) noexcept
+template <TermResult InstrFn(AdvancedExecutionState&) noexcept, typename InstructionT = Instruction>
+const InstructionT* op(const InstructionT* /*instr*/, AdvancedExecutionState& state) noexcept
 {
     const auto result = InstrFn(state);
     state.gas_left = result.gas_left;
-    return state.exit(result.status);
+    return state.exit<InstructionT>(result.status);
 }
 
 const Instruction* op_sstore(const Instruction* instr, AdvancedExecutionState& state) noexcept
@@ -124,20 +126,26 @@ const Instruction* op_sstore(const Instruction* instr, AdvancedExecutionState& s
     return ++instr;
 }
 
-const Instruction* opx_beginblock(const Instruction* instr, AdvancedExecutionState& state) noexcept
+/// Checks the basic block requirements and charges the block base gas cost.
+inline zvmc_status_code begin_block(const BlockInfo& block, AdvancedExecutionState& state) noexcept
 {
-    auto& block = instr->arg.block;
-
     if ((state.gas_left -= block.gas_cost) < 0)
-        return state.exit(ZVMC_OUT_OF_GAS);
+        return ZVMC_OUT_OF_GAS;
 
     if (static_cast<int>(state.stack.size()) < block.stack_req)
-        return state.exit(ZVMC_STACK_UNDERFLOW);
+        return ZVMC_STACK_UNDERFLOW;
 
     if (static_cast<int>(state.stack.size()) + block.stack_max_growth > StackSpace::limit)
-        return state.exit(ZVMC_STACK_OVERFLOW);
+        return ZVMC_STACK_OVERFLOW;
 
     state.current_block_cost = block.gas_cost;
+    return ZVMC_SUCCESS;
+}
+
+const Instruction* opx_beginblock(const Instruction* instr, AdvancedExecutionState& state) noexcept
+{
+    if (const auto status = begin_block(instr->arg.block, state); status != ZVMC_SUCCESS)
+        return state.exit(status);
     return ++instr;
 }
 
@@ -168,6 +176,26 @@ const Instruction* op_jumpi(const Instruction* instr, AdvancedExecutionState& st
     return instr;
 }
 
+const Instruction* op_jump_static(const Instruction* instr, AdvancedExecutionState& state) noexcept
+{
+    const auto target = instr->arg.number;
+    if (target < 0)
+        return state.exit(ZVMC_BAD_JUMP_DESTINATION);
+
+    return &state.analysis.advanced->instrs[static_cast<size_t>(target)];
+}
+
+const Instruction* op_jumpi_static(const Instruction* instr, AdvancedExecutionState& state) noexcept
+{
+    // The destination has not been pushed so the condition is the top stack item.
+    const auto condition = state.stack.top() != 0;
+    state.stack.pop();
+    if (condition)
+        return op_jump_static(instr, state);
+
+    return opx_beginblock(instr + 1, state);  // The JUMPI keeps the follow-by block.
+}
+
 const Instruction* op_pc(const Instruction* instr, AdvancedExecutionState& state) noexcept
 {
     state.stack.push(instr->arg.number);
@@ -261,8 +289,150 @@ constexpr std::array<instruction_exec_fn, 256> instruction_implementations = [](
 
     return table;
 }();
+
+/// The implementations of the compact instructions accessing the instruction argument.
+/// See CompactInstruction for the argument interpretation.
+/// @{
+const CompactInstruction* opc_beginblock(
+    const CompactInstruction* instr, AdvancedExecutionState& state) noexcept
+{
+    const auto& block = state.analysis.advanced_compact->blocks[instr->arg()];
+    if (const auto status = begin_block(block, state); status != ZVMC_SUCCESS)
+        return state.exit<CompactInstruction>(status);
+    return ++instr;
+}
+
+const CompactInstruction* opc_jump(
+    const CompactInstruction* /*instr*/, AdvancedExecutionState& state) noexcept
+{
+    const auto dst = state.stack.pop();
+    auto pc = -1;
+    if (std::numeric_limits<int>::max() < dst ||
+        (pc = find_jumpdest(*state.analysis.advanced_compact, static_cast<int>(dst))) < 0)
+        return state.exit<CompactInstruction>(ZVMC_BAD_JUMP_DESTINATION);
+
+    return &state.analysis.advanced_compact->instrs[static_cast<size_t>(pc)];
+}
+
+const CompactInstruction* opc_jumpi(
+    const CompactInstruction* instr, AdvancedExecutionState& state) noexcept
+{
+    if (state.stack[1] != 0)
+    {
+        instr = opc_jump(instr, state);  // target
+        state.stack.pop();               // condition
+    }
+    else
+    {
+        state.stack.pop();                     // target
+        state.stack.pop();                     // condition
+        instr = opc_beginblock(instr, state);  // follow-by block
+    }
+    return instr;
+}
+
+const CompactInstruction* opc_pc(
+    const CompactInstruction* instr, AdvancedExecutionState& state) noexcept
+{
+    state.stack.push(instr->arg());
+    return ++instr;
+}
+
+const CompactInstruction* opc_gas(
+    const CompactInstruction* instr, AdvancedExecutionState& state) noexcept
+{
+    const auto correction =
+        state.current_block_cost - state.analysis.advanced_compact->numbers[instr->arg()];
+    const auto gas = static_cast<uint64_t>(state.gas_left + correction);
+    state.stack.push(gas);
+    return ++instr;
+}
+
+const CompactInstruction* opc_push_inline(
+    const CompactInstruction* instr, AdvancedExecutionState& state) noexcept
+{
+    state.stack.push(instr->arg());
+    return ++instr;
+}
+
+const CompactInstruction* opc_push_small(
+    const CompactInstruction* instr, AdvancedExecutionState& state) noexcept
+{
+    state.stack.push(state.analysis.advanced_compact->small_push_values[instr->arg()]);
+    return ++instr;
+}
+
+const CompactInstruction* opc_push_full(
+    const CompactInstruction* instr, AdvancedExecutionState& state) noexcept
+{
+    state.stack.push(state.analysis.advanced_compact->push_values[instr->arg()]);
+    return ++instr;
+}
+
+/// The instructions inspecting the gas left: SSTORE, calls and creates.
+template <Opcode Op>
+const CompactInstruction* opc_gas_corrected(
+    const CompactInstruction* instr, AdvancedExecutionState& state) noexcept
+{
+    const auto gas_left_correction =
+        state.current_block_cost - state.analysis.advanced_compact->numbers[instr->arg()];
+    state.gas_left += gas_left_correction;
+
+    const auto status = instr::impl<Op>(state);
+    if (status != ZVMC_SUCCESS)
+        return state.exit<CompactInstruction>(status);
+
+    if ((state.gas_left -= gas_left_correction) < 0)
+        return state.exit<CompactInstruction>(ZVMC_OUT_OF_GAS);
+
+    return ++instr;
+}
+
+const CompactInstruction* opc_undefined(
+    const CompactInstruction* /*instr*/, AdvancedExecutionState& state) noexcept
+{
+    return state.exit<CompactInstruction>(ZVMC_UNDEFINED_INSTRUCTION);
+}
+/// @}
+
+constexpr CompactOpTable compact_instruction_implementations = []() noexcept {
+    CompactOpTable table{};
+
+    // Init table with wrapped generic implementations.
+#define ON_OPCODE(OPCODE) table[OPCODE] = op<instr::impl<(OPCODE)>, CompactInstruction>;
+    MAP_OPCODES
+#undef ON_OPCODE
+
+    // Overwrite with the implementations accessing the compact instruction argument.
+    table[OP_SSTORE] = opc_gas_corrected<OP_SSTORE>;
+    table[OP_JUMP] = opc_jump;
+    table[OP_JUMPI] = opc_jumpi;
+    table[OP_PC] = opc_pc;
+    table[OP_GAS] = opc_gas;
+    table[OP_JUMPDEST] = opc_beginblock;
+
+    for (auto op = size_t{OP_PUSH1}; op <= OP_PUSH3; ++op)
+        table[op] = opc_push_inline;
+    for (auto op = size_t{OP_PUSH4}; op <= OP_PUSH8; ++op)
+        table[op] = opc_push_small;
+    for (auto op = size_t{OP_PUSH9}; op <= OP_PUSH32; ++op)
+        table[op] = opc_push_full;
+
+    table[OP_CREATE] = opc_gas_corrected<OP_CREATE>;
+    table[OP_CALL] = opc_gas_corrected<OP_CALL>;
+    table[OP_DELEGATECALL] = opc_gas_corrected<OP_DELEGATECALL>;
+    table[OP_CREATE2] = opc_gas_corrected<OP_CREATE2>;
+    table[OP_STATICCALL] = opc_gas_corrected<OP_STATICCALL>;
+
+    return table;
+}();
 }  // namespace
 
+ZVMC_EXPORT instruction_exec_fn get_static_jump_fn(bool conditional) noexcept
+{
+    return conditional ? op_jumpi_static : op_jump_static;
+}
+
 ZVMC_EXPORT const OpTable& get_op_table(zvmc_revision rev) noexcept
 {
     static constexpr auto op_tables = []() noexcept {
@@ -293,4 +463,24 @@ ZVMC_EXPORT const OpTable& get_op_table(zvmc_revision rev) noexcept
 
     return op_tables[rev];
 }
+
+ZVMC_EXPORT const CompactOpTable& get_compact_op_table(zvmc_revision rev) noexcept
+{
+    static constexpr auto op_tables = []() noexcept {
+        std::array<CompactOpTable, ZVMC_MAX_REVISION + 1> tables{};
+        for (size_t r = ZVMC_SHANGHAI; r <= ZVMC_MAX_REVISION; ++r)
+        {
+            auto& table = tables[r];
+            for (size_t i = 0; i < table.size(); ++i)
+            {
+                table[i] = (instr::gas_costs[r][i] == instr::undefined) ?
+                               opc_undefined :
+                               compact_instruction_implementations[i];
+            }
+        }
+        return tables;
+    }();
+
+    return op_tables[rev];
+}
 }  // namespace zvmone::advanced
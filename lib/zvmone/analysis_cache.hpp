@@ -0,0 +1,246 @@
+// zvmone: Fast Zond Virtual Machine implementation
+// Copyright 2026 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <zvmc/zvmc.h>
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace zvmone
+{
+using bytes = std::basic_string<uint8_t>;
+using bytes_view = std::basic_string_view<uint8_t>;
+
+/// Computes the fast, non-cryptographic 64-bit hash of the code.
+///
+/// This is only used as a cache key. Cache entries are always verified
+/// by comparing the full code so collisions are harmless.
+inline uint64_t hash_code(bytes_view code) noexcept
+{
+    constexpr uint64_t multiplier = 0x9e3779b97f4a7c15;
+
+    auto h = uint64_t{code.size()} * multiplier;
+    const auto mix = [&h](uint64_t w) noexcept {
+        h = (h ^ w) * multiplier;
+        h ^= h >> 29;
+    };
+
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= code.size(); i += sizeof(uint64_t))
+    {
+        uint64_t w;
+        std::memcpy(&w, &code[i], sizeof(w));
+        mix(w);
+    }
+    if (i != code.size())
+    {
+        uint64_t w = 0;
+        std::memcpy(&w, &code[i], code.size() - i);
+        mix(w);
+    }
+    return h;
+}
+
+/// The counters of the AnalysisCache.
+struct AnalysisCacheStats
+{
+    uint64_t hits = 0;       ///< The number of lookups served from the cache.
+    uint64_t misses = 0;     ///< The number of lookups which required the code analysis.
+    uint64_t evictions = 0;  ///< The number of entries dropped because of the capacity limit.
+};
+
+/// The analysis keeping the analyzed code as its executable code unless it is fused,
+/// e.g. baseline::CodeAnalysis. The cache verifies the hits against it instead of keeping
+/// another copy of the code.
+template <typename AnalysisT>
+concept KeepsAnalyzedCode = requires(const AnalysisT& analysis) {
+    { analysis.executable_code } -> std::convertible_to<bytes_view>;
+    { analysis.is_fused() } -> std::same_as<bool>;
+};
+
+/// The bounded, thread-safe LRU cache of code analyses.
+///
+/// The entries are keyed by the ZVM revision, the analysis variant and the code hash,
+/// and verified by the full code comparison. The analyses are shared with the users so
+/// the evicted entry stays valid as long as any execution still uses it.
+///
+/// The large cache is split by the key into shards with separate locks and LRU lists
+/// so the concurrent lookups rarely wait for each other.
+template <typename AnalysisT>
+class AnalysisCache
+{
+    struct Entry
+    {
+        uint64_t key;
+        zvmc_revision rev;
+        uint32_t variant;
+
+        /// The copy of the code if the analysis does not keep it, see analyzed_code().
+        bytes code;
+
+        std::shared_ptr<const AnalysisT> analysis;
+    };
+
+    using EntryList = std::list<Entry>;
+
+    struct Shard
+    {
+        size_t capacity = 0;
+
+        std::mutex mutex;
+
+        /// The entries in the order from the most to the least recently used.
+        EntryList entries;
+
+        /// The index of the entries by the key.
+        std::unordered_map<uint64_t, typename EntryList::iterator> index;
+
+        AnalysisCacheStats stats;
+    };
+
+    /// The maximum number of shards.
+    static constexpr size_t max_shards = 16;
+
+    /// The minimum capacity of a shard. The smaller caches are not split.
+    static constexpr size_t min_shard_capacity = 64;
+
+    const size_t m_capacity;
+    const size_t m_num_shards;
+    const std::unique_ptr<Shard[]> m_shards;
+
+    static uint64_t make_key(zvmc_revision rev, uint32_t variant, bytes_view code) noexcept
+    {
+        return hash_code(code) ^ (uint64_t{variant} << 32 | static_cast<uint64_t>(rev));
+    }
+
+    static bool keeps_code(const AnalysisT& analysis) noexcept
+    {
+        if constexpr (KeepsAnalyzedCode<AnalysisT>)
+            return !analysis.is_fused();
+        else
+            return false;
+    }
+
+    /// Returns the code of the entry: kept by the analysis or the entry's copy.
+    static bytes_view analyzed_code(const Entry& entry) noexcept
+    {
+        if constexpr (KeepsAnalyzedCode<AnalysisT>)
+        {
+            if (keeps_code(*entry.analysis))
+                return entry.analysis->executable_code;
+        }
+        return entry.code;
+    }
+
+    Shard& shard(uint64_t key) const noexcept { return m_shards[key % m_num_shards]; }
+
+public:
+    /// Creates the cache with the maximum number of entries. The capacity must not be 0.
+    explicit AnalysisCache(size_t capacity)
+      : m_capacity{capacity},
+        m_num_shards{std::clamp(capacity / min_shard_capacity, size_t{1}, max_shards)},
+        m_shards{std::make_unique<Shard[]>(m_num_shards)}
+    {
+        assert(capacity != 0);
+        for (size_t i = 0; i < m_num_shards; ++i)
+            m_shards[i].capacity = capacity / m_num_shards + size_t{i < capacity % m_num_shards};
+    }
+
+    AnalysisCache(const AnalysisCache&) = delete;
+    AnalysisCache& operator=(const AnalysisCache&) = delete;
+
+    /// Returns the analysis of the code from the cache or creates it with the provided function.
+    ///
+    /// The variant identifies the options of the analysis. The analyses of the same code
+    /// with different variants are cached separately.
+    ///
+    /// The analysis function is invoked outside of the cache lock so concurrent lookups of other
+    /// code are not blocked by it. Throws std::bad_alloc if the new entry cannot be allocated.
+    template <typename AnalyzeFn>
+    std::shared_ptr<const AnalysisT> get(
+        zvmc_revision rev, bytes_view code, AnalyzeFn analyze_fn, uint32_t variant = 0)
+    {
+        const auto key = make_key(rev, variant, code);
+        auto& s = shard(key);
+        {
+            const std::lock_guard lock{s.mutex};
+            if (const auto it = s.index.find(key); it != s.index.end())
+            {
+                const auto entry = it->second;
+                if (entry->rev == rev && entry->variant == variant &&
+                    analyzed_code(*entry) == code)
+                {
+                    // Move the entry to the front: it is the most recently used now.
+                    s.entries.splice(s.entries.begin(), s.entries, entry);
+                    ++s.stats.hits;
+                    return entry->analysis;
+                }
+            }
+            ++s.stats.misses;
+        }
+
+        auto analysis = std::make_shared<const AnalysisT>(analyze_fn(rev, code));
+        auto code_copy = keeps_code(*analysis) ? bytes{} : bytes{code};
+
+        const std::lock_guard lock{s.mutex};
+        if (const auto it = s.index.find(key); it != s.index.end())
+        {
+            // Replace the entry with the same key. This is either a hash collision
+            // or the same code has been analyzed concurrently.
+            s.entries.erase(it->second);
+            s.index.erase(it);
+        }
+        else if (s.entries.size() == s.capacity)
+        {
+            s.index.erase(s.entries.back().key);
+            s.entries.pop_back();
+            ++s.stats.evictions;
+        }
+        s.entries.push_front({key, rev, variant, std::move(code_copy), analysis});
+        s.index.emplace(key, s.entries.begin());
+        return analysis;
+    }
+
+    /// Returns the maximum number of entries.
+    [[nodiscard]] size_t capacity() const noexcept { return m_capacity; }
+
+    /// Returns the number of shards.
+    [[nodiscard]] size_t num_shards() const noexcept { return m_num_shards; }
+
+    /// Returns the current number of entries.
+    [[nodiscard]] size_t size() const noexcept
+    {
+        size_t n = 0;
+        for (size_t i = 0; i < m_num_shards; ++i)
+        {
+            const std::lock_guard lock{m_shards[i].mutex};
+            n += m_shards[i].entries.size();
+        }
+        return n;
+    }
+
+    /// Returns the snapshot of the cache counters.
+    [[nodiscard]] AnalysisCacheStats stats() const noexcept
+    {
+        AnalysisCacheStats total;
+        for (size_t i = 0; i < m_num_shards; ++i)
+        {
+            const std::lock_guard lock{m_shards[i].mutex};
+            total.hits += m_shards[i].stats.hits;
+            total.misses += m_shards[i].stats.misses;
+            total.evictions += m_shards[i].stats.evictions;
+        }
+        return total;
+    }
+};
+}  // namespace zvmone
@@ -0,0 +1,78 @@
+// zvmone: Fast Zond Virtual Machine implementation
+// Copyright 2026 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "aot.hpp"
+#include <algorithm>
+#include <filesystem>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define ZVMONE_AOT_DLOPEN 1
+#include <dlfcn.h>
+#else
+#define ZVMONE_AOT_DLOPEN 0
+#endif
+
+namespace zvmone::aot
+{
+void Registry::LibraryCloser::operator()([[maybe_unused]] void* handle) const noexcept
+{
+#if ZVMONE_AOT_DLOPEN
+    dlclose(handle);
+#endif
+}
+
+bool Registry::add(const Library& library)
+{
+    if (library.abi_version != abi_version)
+        return false;
+
+    for (size_t i = 0; i < library.num_contracts; ++i)
+    {
+        const auto& contract = library.contracts[i];
+        const bytes_view code{contract.code, contract.code_size};
+
+        // The revision only matters for the optional parts of the analysis.
+        m_contracts.try_emplace(hash_code(code),
+            Entry{bytes{code}, contract.fn, baseline::analyze(ZVMC_SHANGHAI, code)});
+    }
+    return true;
+}
+
+bool Registry::load_directory([[maybe_unused]] const std::string& path)
+{
+#if ZVMONE_AOT_DLOPEN
+    namespace fs = std::filesystem;
+
+    std::error_code ec;
+    std::vector<fs::path> files;
+    for (fs::directory_iterator it{path, ec}, end; !ec && it != end; it.increment(ec))
+    {
+        if (it->path().extension() == ".so")
+            files.push_back(it->path());
+    }
+    if (ec)
+        return false;
+
+    // Load in the deterministic order: the first registered contract wins the duplicates.
+    std::sort(files.begin(), files.end());
+
+    for (const auto& file : files)
+    {
+        std::unique_ptr<void, LibraryCloser> handle{dlopen(file.c_str(), RTLD_NOW | RTLD_LOCAL)};
+        if (handle == nullptr)
+            return false;
+
+        const auto* const library =
+            static_cast<const Library*>(dlsym(handle.get(), library_symbol));
+        if (library == nullptr || !add(*library))
+            return false;
+
+        m_libraries.emplace_back(std::move(handle));
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+}  // namespace zvmone::aot
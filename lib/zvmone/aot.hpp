@@ -0,0 +1,133 @@
+// zvmone: Fast Zond Virtual Machine implementation
+// Copyright 2026 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "analysis_cache.hpp"
+#include "baseline.hpp"
+#include "baseline_instruction_table.hpp"
+#include <intx/intx.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace zvmone
+{
+class ExecutionState;
+}
+
+/// The ahead-of-time compiled contracts.
+///
+/// The zvmone-aot tool translates the contract code to the C++ source using the helpers
+/// from aot_runtime.hpp. The source compiled to a shared library exports the Library descriptor
+/// under the name of library_symbol. The Registry loads the libraries and maps the contracts
+/// by the code.
+///
+/// The compiled code and zvmone exchange C++ types so the library must be built against
+/// the zvmone sources of the same version. The abi_version guards the descriptor layout.
+namespace zvmone::aot
+{
+using uint256 = intx::uint256;
+using code_iterator = const uint8_t*;
+
+/// The version of the interface between the compiled contracts and zvmone.
+inline constexpr uint32_t abi_version = 1;
+
+/// The name of the exported Library descriptor.
+inline constexpr char library_symbol[] = "zvmone_aot_library";
+
+struct Context;
+
+/// The instruction executed by zvmone on behalf of the compiled code with the per-instruction
+/// checks. Returns the position of the next instruction or null if the execution stops.
+using StepFn = code_iterator (*)(
+    const Context& ctx, code_iterator code_it, uint256*& stack_top, int64_t& gas) noexcept;
+
+/// The execution context passed by zvmone to the compiled contract.
+struct Context
+{
+    ExecutionState& state;
+    const baseline::CostTable& cost_table;
+    uint256* stack_bottom;
+
+    /// The beginning of the Baseline executable code. The code positions passed to
+    /// the step functions point into it.
+    const uint8_t* code;
+
+    /// The step functions indexed by opcode.
+    const StepFn* steps;
+};
+
+/// The compiled contract function. Returns the gas left.
+using ContractFn = int64_t (*)(const Context& ctx, int64_t gas) noexcept;
+
+/// The compiled contract.
+struct Contract
+{
+    const uint8_t* code;  ///< The original code.
+    size_t code_size;
+    ContractFn fn;
+};
+
+/// The descriptor of the library of the compiled contracts.
+struct Library
+{
+    uint32_t abi_version;
+    size_t num_contracts;
+    const Contract* contracts;
+};
+
+/// The registry of the compiled contracts.
+class Registry
+{
+public:
+    /// The registered contract.
+    struct Entry
+    {
+        bytes code;
+        ContractFn fn;
+
+        /// The Baseline code analysis used by the step functions.
+        baseline::CodeAnalysis analysis;
+    };
+
+private:
+    /// The entries by the code hash. On the hash collision the first contract is kept.
+    std::unordered_map<uint64_t, Entry> m_contracts;
+
+    struct LibraryCloser
+    {
+        void operator()(void* handle) const noexcept;
+    };
+
+    /// The handles of the loaded shared libraries.
+    std::vector<std::unique_ptr<void, LibraryCloser>> m_libraries;
+
+public:
+    Registry() = default;
+    Registry(const Registry&) = delete;
+    Registry& operator=(const Registry&) = delete;
+
+    /// Registers the contracts of the library.
+    /// Returns false if the library has the incompatible ABI version.
+    bool add(const Library& library);
+
+    /// Loads the shared libraries (*.so) from the directory and registers their contracts.
+    /// Returns false if the directory cannot be read or any library cannot be loaded.
+    bool load_directory(const std::string& path);
+
+    /// Returns the compiled contract of the code or null if it is not registered.
+    [[nodiscard]] const Entry* find(bytes_view code) const noexcept
+    {
+        const auto it = m_contracts.find(hash_code(code));
+        if (it == m_contracts.end() || bytes_view{it->second.code} != code)
+            return nullptr;
+        return &it->second;
+    }
+
+    /// Returns the number of registered contracts.
+    [[nodiscard]] size_t size() const noexcept { return m_contracts.size(); }
+};
+}  // namespace zvmone::aot
@@ -0,0 +1,71 @@
+// zvmone: Fast Zond Virtual Machine implementation
+// Copyright 2026 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+/// @file
+/// The helpers used by the C++ source of the contracts generated by zvmone-aot.
+
+#include "aot.hpp"
+#include "baseline_checks.hpp"
+#include "instructions.hpp"
+#include <type_traits>
+
+namespace zvmone::aot
+{
+/// Checks if the instruction is executed directly in the compiled code: the stack-only
+/// instructions implemented in the headers. Other instructions are executed by the step functions.
+template <Opcode Op>
+constexpr bool is_inlined() noexcept
+{
+    using StackOnlyFn = void (*)(StackTop) noexcept;
+    return std::is_same_v<std::remove_const_t<decltype(instr::core::impl<Op>)>, StackOnlyFn>;
+}
+
+/// Executes the instruction at the code offset.
+/// Returns the position of the next instruction or null if the execution stops.
+template <Opcode Op>
+[[gnu::always_inline]] inline code_iterator step(
+    const Context& ctx, size_t offset, uint256*& stack_top, int64_t& gas) noexcept
+{
+    if constexpr (is_inlined<Op>())
+    {
+        if (const auto status =
+                baseline::check_requirements<Op>(ctx.cost_table, gas, stack_top, ctx.stack_bottom);
+            status != ZVMC_SUCCESS)
+        {
+            ctx.state.status = status;
+            return nullptr;
+        }
+        instr::core::impl<Op>(stack_top);
+        stack_top += instr::traits[Op].stack_height_change;
+        return &ctx.code[offset + 1];
+    }
+    else
+        return ctx.steps[Op](ctx, &ctx.code[offset], stack_top, gas);
+}
+
+/// Executes the PUSH instruction with the value decoded by the compiler.
+template <Opcode Op>
+[[gnu::always_inline]] inline bool push(
+    const Context& ctx, const uint256& value, uint256*& stack_top, int64_t& gas) noexcept
+{
+    static_assert(Op >= OP_PUSH1 && Op <= OP_PUSH32);
+    if (const auto status =
+            baseline::check_requirements<Op>(ctx.cost_table, gas, stack_top, ctx.stack_bottom);
+        status != ZVMC_SUCCESS)
+    {
+        ctx.state.status = status;
+        return false;
+    }
+    *++stack_top = value;
+    return true;
+}
+
+/// Stops the execution at the undefined instruction.
+inline int64_t undefined(const Context& ctx, int64_t gas) noexcept
+{
+    ctx.state.status = ZVMC_UNDEFINED_INSTRUCTION;
+    return gas;
+}
+}  // namespace zvmone::aot
@@ -0,0 +1,326 @@
+// zvmone: Fast Zond Virtual Machine implementation
+// Copyright 2026 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <intx/intx.hpp>
+#include <bit>
+
+/// The implementations of the ZVM division, modular arithmetic and exponentiation dispatching
+/// on the operands width. The operands fitting in 64 or 128 bits (the common case) are detected
+/// with cheap checks of the high words and handled with the native or 128-bit arithmetic.
+/// The other operands fall back to the full precision intx implementations.
+/// The results are identical to the intx ones.
+namespace zvmone::arith
+{
+using uint256 = intx::uint256;
+
+/// The int64_sign() result for the values not fitting in signed 64 bits.
+constexpr uint64_t not_int64 = 1;
+
+/// Returns true if the value fits in 64 bits.
+[[nodiscard]] inline bool fits_64(const uint256& x) noexcept
+{
+    return (x[3] | x[2] | x[1]) == 0;
+}
+
+/// Returns true if the value fits in 128 bits.
+[[nodiscard]] inline bool fits_128(const uint256& x) noexcept
+{
+    return (x[3] | x[2]) == 0;
+}
+
+/// Returns the sign mask (all bits set for negative values) if the value is the sign extension
+/// of a signed 64-bit value. Returns the not_int64 otherwise.
+[[nodiscard]] inline uint64_t int64_sign(const uint256& x) noexcept
+{
+    const auto sign = static_cast<uint64_t>(static_cast<int64_t>(x[0]) >> 63);
+    return ((x[3] ^ sign) | (x[2] ^ sign) | (x[1] ^ sign)) == 0 ? sign : not_int64;
+}
+
+/// Returns the absolute value of the signed 64-bit value with the given sign mask.
+[[nodiscard]] inline uint64_t abs_64(uint64_t x, uint64_t sign) noexcept
+{
+    return (x ^ sign) - sign;
+}
+
+/// Returns the negated value if the sign mask is set.
+[[nodiscard]] inline uint256 apply_sign(uint64_t x, uint64_t sign) noexcept
+{
+    const uint256 r{x};
+    return sign != 0 ? -r : r;
+}
+
+/// The unsigned division x / y. The y must not be 0.
+[[nodiscard]] inline uint256 div(const uint256& x, const uint256& y) noexcept
+{
+    if (fits_128(x))
+    {
+        if (fits_64(x))
+            return fits_64(y) ? uint256{x[0] / y[0]} : 0;
+        if (fits_128(y))
+        {
+            const auto q = intx::uint128{x[0], x[1]} / intx::uint128{y[0], y[1]};
+            return uint256{q[0], q[1]};
+        }
+        return 0;  // The y is greater than x.
+    }
+    return x / y;
+}
+
+/// The unsigned remainder x % y. The y must not be 0.
+[[nodiscard]] inline uint256 mod(const uint256& x, const uint256& y) noexcept
+{
+    if (fits_128(x))
+    {
+        if (fits_64(x))
+            return fits_64(y) ? uint256{x[0] % y[0]} : x;
+        if (fits_128(y))
+        {
+            const auto r = intx::uint128{x[0], x[1]} % intx::uint128{y[0], y[1]};
+            return uint256{r[0], r[1]};
+        }
+        return x;  // The y is greater than x.
+    }
+    return x % y;
+}
+
+/// The signed division x / y. The y must not be 0.
+[[nodiscard]] inline uint256 sdiv(const uint256& x, const uint256& y) noexcept
+{
+    const auto x_sign = int64_sign(x);
+    const auto y_sign = int64_sign(y);
+    if (x_sign != not_int64 && y_sign != not_int64)
+    {
+        // The magnitudes fit in 64 bits, including the one of the minimal int64 value.
+        return apply_sign(abs_64(x[0], x_sign) / abs_64(y[0], y_sign), x_sign ^ y_sign);
+    }
+    return intx::sdivrem(x, y).quot;
+}
+
+/// The signed remainder x % y with the sign of x. The y must not be 0.
+[[nodiscard]] inline uint256 smod(const uint256& x, const uint256& y) noexcept
+{
+    const auto x_sign = int64_sign(x);
+    const auto y_sign = int64_sign(y);
+    if (x_sign != not_int64 && y_sign != not_int64)
+        return apply_sign(abs_64(x[0], x_sign) % abs_64(y[0], y_sign), x_sign);
+    return intx::sdivrem(x, y).rem;
+}
+
+/// The (x + y) % m without the 2^256 wrap-around. The m must not be 0.
+[[nodiscard]] inline uint256 addmod(const uint256& x, const uint256& y, const uint256& m) noexcept
+{
+    if (fits_64(x) && fits_64(y) && fits_64(m))
+    {
+        const auto m0 = m[0];
+        const auto a = x[0] % m0;
+        const auto b = y[0] % m0;
+        // The sum of the values less than m wraps around 2^64 at most once
+        // and then the wrapped sum is less than m.
+        const auto s = a + b;
+        return uint256{(s < a || s >= m0) ? s - m0 : s};
+    }
+
+    // The sum of the values less than 2^255 does not overflow. The intx::addmod() is faster
+    // for the large m with the comparably large x and y.
+    if (m[3] == 0 && ((x[3] | y[3]) >> 63) == 0)
+        return (x + y) % m;
+    return intx::addmod(x, y, m);
+}
+
+/// The exponentiation base^exponent modulo 2^256.
+///
+/// The power-of-two base 2^k (e.g. 2 or 256 in the Solidity byte masks) is computed
+/// with the shift 1 << (k * exponent). The exponent fitting in 64 bits is processed
+/// with the native 64-bit arithmetic, with the shortest multiplication chains
+/// for the exponents up to 4.
+[[nodiscard]] inline uint256 exp(const uint256& base, const uint256& exponent) noexcept
+{
+    if (base != 0 && (base & (base - 1)) == 0)
+    {
+        const auto k = 255 - intx::clz(base);
+        if (k == 0)
+            return 1;
+        // The exponent >= 256 shifts out the bit for any k >= 1.
+        if (!fits_64(exponent) || exponent[0] >= 256)
+            return 0;
+        const auto shift = k * exponent[0];
+        return shift < 256 ? uint256{1} << shift : 0;
+    }
+
+    if (!fits_64(exponent))
+        return intx::exp(base, exponent);
+
+    const auto e = exponent[0];
+    switch (e)
+    {
+    case 0:
+        return 1;
+    case 1:
+        return base;
+    case 2:
+        return base * base;
+    case 3:
+        return base * base * base;
+    case 4:
+    {
+        const auto b2 = base * base;
+        return b2 * b2;
+    }
+    default:
+    {
+        // The left-to-right binary method starting below the top exponent bit.
+        auto r = base;
+        for (auto bit = uint64_t{1} << (std::bit_width(e) - 2); bit != 0; bit >>= 1)
+        {
+            r *= r;
+            if ((e & bit) != 0)
+                r *= base;
+        }
+        return r;
+    }
+    }
+}
+
+/// The Barrett reduction modulo the fixed modulus with the precomputed reciprocal.
+///
+/// The modulus is normalized by the left shift so that its top bit is set and the reciprocal
+/// v = floor((2^512 - 1) / d) - 2^256 of the normalized modulus d fits in 256 bits.
+/// The quotient of the 512-bit product by d is then estimated with the multiplication
+/// by the reciprocal and corrected by at most a few subtractions of d.
+class BarrettReducer
+{
+    uint256 m_divisor = 0;     ///< The normalized modulus d.
+    uint256 m_reciprocal = 0;  ///< The reciprocal v of d.
+    unsigned m_shift = 0;      ///< The normalization shift.
+
+    [[nodiscard]] static uint256 hi(const intx::uint512& x) noexcept
+    {
+        return {x[4], x[5], x[6], x[7]};
+    }
+
+    [[nodiscard]] static uint256 lo(const intx::uint512& x) noexcept
+    {
+        return {x[0], x[1], x[2], x[3]};
+    }
+
+    [[nodiscard]] static intx::uint512 extend(const uint256& x) noexcept
+    {
+        return {x[0], x[1], x[2], x[3]};
+    }
+
+public:
+    BarrettReducer() = default;
+
+    /// Precomputes the reduction modulo m. The m must not be 0.
+    explicit BarrettReducer(const uint256& m) noexcept
+      : m_divisor{m << intx::clz(m)}, m_shift{intx::clz(m)}
+    {
+        // The quotient is in [2^256, 2^257) because the d top bit is set.
+        m_reciprocal = lo(~intx::uint512{} / extend(m_divisor));
+    }
+
+    /// Returns (x * y) % m. The x and y must be less than m.
+    [[nodiscard]] uint256 mulmod(const uint256& x, const uint256& y) const noexcept
+    {
+        // The shifted product p < m^2 * 2^shift <= d^2 so its high half is less than d
+        // and the quotient fits in 256 bits.
+        const auto p = intx::umul(x, y) << m_shift;
+        const auto p_hi = hi(p);
+
+        // The estimate floor(p_hi * (2^256 + v) / 2^256) is not greater than the quotient.
+        const auto q = p_hi + hi(intx::umul(p_hi, m_reciprocal));
+        auto r = p - intx::umul(q, m_divisor);
+        const auto d = extend(m_divisor);
+        while (r >= d)
+            r -= d;
+        return lo(r) >> m_shift;
+    }
+};
+
+/// The cache of the Barrett reducers for the MULMOD moduli repeated within an execution.
+///
+/// The recently used moduli are remembered and the reducer is precomputed when
+/// a modulus is used again. This pays off in the elliptic curve arithmetic
+/// executing many MULMODs with the same modulus.
+class ModulusCache
+{
+    struct Entry
+    {
+        uint256 modulus = 0;     ///< The modulus or 0 for the empty entry.
+        bool prepared = false;   ///< Whether the reducer has been precomputed.
+        BarrettReducer reducer;  ///< The reducer for the modulus.
+    };
+
+    /// The number of the remembered moduli.
+    static constexpr size_t num_entries = 4;
+
+    Entry m_entries[num_entries];
+
+    /// The index of the entry replaced by the next new modulus.
+    size_t m_next = 0;
+
+public:
+    /// Returns the reducer for the modulus if it has been used before.
+    /// Otherwise, remembers the modulus and returns null. The m must not be 0.
+    [[nodiscard]] const BarrettReducer* get(const uint256& m) noexcept
+    {
+        for (auto& e : m_entries)
+        {
+            if (e.modulus == m)
+            {
+                if (!e.prepared) [[unlikely]]
+                {
+                    e.reducer = BarrettReducer{m};
+                    e.prepared = true;
+                }
+                return &e.reducer;
+            }
+        }
+
+        auto& e = m_entries[m_next];
+        m_next = (m_next + 1) % num_entries;
+        e.modulus = m;
+        e.prepared = false;
+        return nullptr;
+    }
+
+    /// Forgets all moduli.
+    void clear() noexcept
+    {
+        for (auto& e : m_entries)
+            e.modulus = 0;
+    }
+};
+
+/// The (x * y) % m without the 2^256 wrap-around. The m must not be 0.
+[[nodiscard]] inline uint256 mulmod(const uint256& x, const uint256& y, const uint256& m) noexcept
+{
+    if (fits_128(x) && fits_128(y))
+    {
+        if (fits_64(x) && fits_64(y) && fits_64(m))
+        {
+            const auto r = intx::umul(x[0], y[0]) % intx::uint128{m[0]};
+            return uint256{r[0]};
+        }
+        return x * y % m;  // The product of 128-bit values does not overflow.
+    }
+    return intx::mulmod(x, y, m);
+}
+
+/// The (x * y) % m using the precomputed reduction for the modulus repeated in the cache.
+/// The m must not be 0.
+[[nodiscard]] inline uint256 mulmod(
+    const uint256& x, const uint256& y, const uint256& m, ModulusCache& cache) noexcept
+{
+    // The reduction requires the reduced operands which is always the case
+    // in the modular arithmetic of the large moduli.
+    if (!(fits_128(x) && fits_128(y)) && x < m && y < m)
+    {
+        if (const auto* reducer = cache.get(m))
+            return reducer->mulmod(x, y);
+    }
+    return arith::mulmod(x, y, m);
+}
+}  // namespace zvmone::arith
@@ -2,12 +2,24 @@
 // Copyright 2020 The evmone Authors.
 // SPDX-License-Identifier: Apache-2.0
 
+#include "advanced_analysis.hpp"
+#include "advanced_execution.hpp"
+#include "aot.hpp"
 #include "baseline.hpp"
+#include "baseline_checks.hpp"
 #include "baseline_instruction_table.hpp"
 #include "execution_state.hpp"
+#include "execution_state_pool.hpp"
 #include "instructions.hpp"
+#include "jumpdest_analysis.hpp"
+#include "keccak_cache.hpp"
 #include "vm.hpp"
+#include <algorithm>
+#include <array>
+#include <initializer_list>
 #include <memory>
+#include <type_traits>
+#include <utility>
 
 #ifdef NDEBUG
 #define release_inline gnu::always_inline, msvc::forceinline
@@ -25,108 +37,328 @@ namespace zvmone::baseline
 {
 namespace
 {
-CodeAnalysis::JumpdestMap analyze_jumpdests(bytes_view code)
+/// Checks if the instruction ends the basic block but the execution may continue
+/// with the next instruction. In the block checks mode the requirements of the following block
+/// are checked right after such instruction.
+///
+/// The instructions inspecting the gas left (GAS, calls, creates and SSTORE) end the block
+/// so that the base gas cost of the following instructions is not charged before them.
+constexpr bool is_block_end_with_fallthrough(uint8_t op) noexcept
+{
+    switch (op)
+    {
+    case OP_JUMPI:
+    case OP_GAS:
+    case OP_CALL:
+    case OP_DELEGATECALL:
+    case OP_STATICCALL:
+    case OP_CREATE:
+    case OP_CREATE2:
+    case OP_SSTORE:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/// The basic block requirements being collected by the analysis.
+struct BlockAnalysis
+{
+    int64_t gas_cost = 0;
+    int stack_req = 0;
+    int stack_max_growth = 0;
+    int stack_change = 0;
+
+    /// Closes the block by producing the clamped requirements.
+    /// The clamped values still fail the checks as the original ones would.
+    [[nodiscard]] BlockRequirements close() const noexcept
+    {
+        constexpr auto max_gas_cost = std::numeric_limits<uint32_t>::max();
+        constexpr auto max_stack = std::numeric_limits<int16_t>::max();
+        return {static_cast<uint32_t>(std::min<int64_t>(gas_cost, max_gas_cost)),
+            static_cast<int16_t>(std::min(stack_req, int{max_stack})),
+            static_cast<int16_t>(std::min(stack_max_growth, int{max_stack}))};
+    }
+};
+
+/// Splits the code into basic blocks and collects their requirements.
+///
+/// A block starts at the code beginning, at every JUMPDEST and after every instruction ending
+/// a block: JUMP, terminating and undefined instructions, and the ones listed in
+/// is_block_end_with_fallthrough(). The blocks following JUMP or terminating instructions
+/// are only reachable through a JUMPDEST, so their requirements are never checked.
+void analyze_blocks(zvmc_revision rev, bytes_view code,
+    std::vector<CodeAnalysis::BlockStartsWord>& block_starts,
+    std::vector<BlockRequirements>& blocks)
 {
-    // To find if op is any PUSH opcode (OP_PUSH1 <= op <= OP_PUSH32)
-    // it can be noticed that OP_PUSH32 is INT8_MAX (0x7f) therefore
-    // static_cast<int8_t>(op) <= OP_PUSH32 is always true and can be skipped.
-    static_assert(OP_PUSH32 == std::numeric_limits<int8_t>::max());
+    const auto& cost_table = get_baseline_cost_table(rev);
+
+    // The block may also start at the code end (e.g. after the final JUMPI).
+    block_starts.resize(CodeAnalysis::bitmap_size(code.size() + 1));
+    block_starts[0].bits = 1;
+
+    BlockAnalysis block;
+    size_t block_start = 0;
+    const auto start_block = [&](size_t position) {
+        blocks.emplace_back(block.close());
+        block = {};
+        block_start = position;
+        block_starts[position / 64].bits |= uint64_t{1} << (position % 64);
+    };
 
-    CodeAnalysis::JumpdestMap map(code.size());  // Allocate and init bitmap with zeros.
     for (size_t i = 0; i < code.size(); ++i)
     {
         const auto op = code[i];
-        if (static_cast<int8_t>(op) >= OP_PUSH1)  // If any PUSH opcode (see explanation above).
-            i += op - size_t{OP_PUSH1 - 1};       // Skip PUSH data.
-        else if (INTX_UNLIKELY(op == OP_JUMPDEST))
-            map[i] = true;
+        if (op == OP_JUMPDEST && i != block_start)
+            start_block(i);
+
+        const auto& tr = instr::traits[op];
+        const auto gas_cost = cost_table[op];
+        const auto is_undefined = gas_cost < 0;
+
+        block.stack_req = std::max(block.stack_req, tr.stack_height_required - block.stack_change);
+        block.stack_change += tr.stack_height_change;
+        block.stack_max_growth = std::max(block.stack_max_growth, block.stack_change);
+        if (!is_undefined)
+            block.gas_cost += gas_cost;
+
+        i += tr.immediate_size;  // Skip PUSH data.
+
+        if (is_undefined || tr.is_terminating || op == OP_JUMP || is_block_end_with_fallthrough(op))
+            start_block(i + 1);
     }
+    blocks.emplace_back(block.close());
 
-    return map;
+    uint32_t rank = 0;
+    for (auto& word : block_starts)
+    {
+        word.rank = rank;
+        rank += static_cast<uint32_t>(std::popcount(word.bits));
+    }
+    assert(rank == blocks.size());
+}
+
+/// The fused instruction (superinstruction): the undefined opcode executing
+/// the sequence of instructions at once.
+struct FusedInstruction
+{
+    static constexpr size_t max_length = 4;
+
+    uint8_t opcode = 0;
+    size_t length = 0;
+    std::array<uint8_t, max_length> sequence{};
+};
+
+/// The fused instructions defined by ON_OPCODE_FUSED in MAP_OPCODES.
+constexpr FusedInstruction fused_instructions[] = {
+#define ON_OPCODE(OPCODE)
+#undef ON_OPCODE_FUSED
+#define ON_OPCODE_FUSED(OPCODE, ...) \
+    {OPCODE, std::initializer_list<uint8_t>{__VA_ARGS__}.size(), {__VA_ARGS__}},
+    MAP_OPCODES
+#undef ON_OPCODE
+#undef ON_OPCODE_FUSED
+#define ON_OPCODE_FUSED ON_OPCODE_FUSED_DEFAULT
+};
+
+/// Checks if the fused instruction executes exactly as its sequence of instructions.
+///
+/// Only the last instruction of the sequence may change the control flow.
+/// JUMPDEST is excluded because it must remain visible at the block start in the block checks mode.
+constexpr bool is_valid_fused_instruction(const FusedInstruction& fused) noexcept
+{
+    if (instr::traits[fused.opcode].name != nullptr)
+        return false;  // The fused instruction must not replace a defined instruction.
+    if (fused.length < 2 || fused.length > FusedInstruction::max_length)
+        return false;
+
+    for (size_t i = 0; i < fused.length; ++i)
+    {
+        const auto op = fused.sequence[i];
+        const auto& tr = instr::traits[op];
+        if (tr.name == nullptr || op == OP_JUMPDEST)
+            return false;
+        const auto is_last = i == fused.length - 1;
+        if (!is_last && (tr.is_terminating || op == OP_JUMP || op == OP_JUMPI))
+            return false;
+    }
+    return true;
 }
 
-std::unique_ptr<uint8_t[]> pad_code(bytes_view code)
+static_assert(std::all_of(std::begin(fused_instructions), std::end(fused_instructions),
+    is_valid_fused_instruction));
+
+/// Checks if the opcode is used by a fused instruction.
+constexpr bool is_fused_opcode(uint8_t op) noexcept
+{
+    return std::any_of(std::begin(fused_instructions), std::end(fused_instructions),
+        [op](const FusedInstruction& fused) noexcept { return fused.opcode == op; });
+}
+
+/// The undefined opcode replacing the occurrences of the fused opcodes in the original code
+/// so that they remain undefined instructions.
+constexpr uint8_t fused_placeholder_opcode = [] {
+    for (size_t op = 0; op < instr::traits.size(); ++op)
+    {
+        if (instr::traits[op].name == nullptr && !is_fused_opcode(static_cast<uint8_t>(op)))
+            return static_cast<uint8_t>(op);
+    }
+    return uint8_t{0};
+}();
+static_assert(instr::traits[fused_placeholder_opcode].name == nullptr);
+static_assert(!is_fused_opcode(fused_placeholder_opcode));
+
+/// Checks if the instruction sequence of the fused instruction starts at the code position.
+/// Returns the position after the sequence or 0 if it does not match.
+size_t match_fused_instruction(bytes_view code, size_t position, const FusedInstruction& fused)
+{
+    for (size_t i = 0; i < fused.length; ++i)
+    {
+        if (position >= code.size() || code[position] != fused.sequence[i])
+            return 0;
+        position += 1 + size_t{instr::traits[code[position]].immediate_size};
+    }
+    return position;
+}
+
+/// Replaces the instruction sequences in the padded code copy with the fused instructions.
+/// The first matching fused instruction in the MAP_OPCODES order is used.
+/// The PUSH data remain in place and the original code is not modified.
+/// @return  True if any fused instruction has been placed.
+bool fuse_instructions(bytes_view code, uint8_t* padded_code) noexcept
+{
+    bool fused = false;
+    for (size_t i = 0; i < code.size();)
+    {
+        const auto op = code[i];
+        if (is_fused_opcode(op))
+        {
+            padded_code[i++] = fused_placeholder_opcode;
+            continue;
+        }
+
+        size_t next = 0;
+        for (const auto& fused_instr : fused_instructions)
+        {
+            if (fused_instr.sequence[0] == op &&
+                (next = match_fused_instruction(code, i, fused_instr)) != 0)
+            {
+                padded_code[i] = fused_instr.opcode;
+                fused = true;
+                break;
+            }
+        }
+        i = (next != 0) ? next : i + 1 + size_t{instr::traits[op].immediate_size};
+    }
+    return fused;
+}
+
+CodeAnalysis analyze_legacy(zvmc_revision rev, bytes_view code, AnalysisOptions options)
 {
     // We need at most 33 bytes of code padding: 32 for possible missing all data bytes of PUSH32
     // at the very end of the code; and one more byte for STOP to guarantee there is a terminating
     // instruction at the code end.
     constexpr auto padding = 32 + 1;
 
+    // The jumpdest bitmap and the padded code are placed in a single allocation:
+    // the bitmap words first, then the code rounded up to the whole words.
+    const auto bitmap_size = CodeAnalysis::bitmap_size(code.size());
+    const auto padded_code_size = (code.size() + padding + 7) / 8 * 8;
+
     // Using "raw" new operator instead of std::make_unique() to get uninitialized array.
-    std::unique_ptr<uint8_t[]> padded_code{new uint8_t[code.size() + padding]};
-    std::copy(std::begin(code), std::end(code), padded_code.get());
-    std::fill_n(&padded_code[code.size()], padding, uint8_t{OP_STOP});
-    return padded_code;
-}
+    std::unique_ptr<uint64_t[]> storage{new uint64_t[bitmap_size + padded_code_size / 8]};
+    std::fill_n(storage.get(), bitmap_size, uint64_t{0});
 
+    auto* const padded_code = reinterpret_cast<uint8_t*>(&storage[bitmap_size]);
+    std::copy(std::begin(code), std::end(code), padded_code);
+    std::fill_n(&padded_code[code.size()], padded_code_size - code.size(), uint8_t{OP_STOP});
 
-CodeAnalysis analyze_legacy(bytes_view code)
-{
-    // TODO: The padded code buffer and jumpdest bitmap can be created with single allocation.
-    return {pad_code(code), code.size(), analyze_jumpdests(code)};
+    // The fusion only modifies the executable code copy. The analyses use the original code.
+    const auto fused = options.fusion && fuse_instructions(code, padded_code);
+
+    // The lazy analysis continues later on the executable code so it must be the original one.
+    const auto lazy_jumpdests = options.lazy_jumpdests && !fused;
+    if (!lazy_jumpdests)
+        analyze_jumpdests(code, storage.get());
+
+    if (!options.block_requirements)
+        return {std::move(storage), code.size(), fused, lazy_jumpdests};
+
+    std::vector<CodeAnalysis::BlockStartsWord> block_starts;
+    std::vector<BlockRequirements> blocks;
+    analyze_blocks(rev, code, block_starts, blocks);
+    return {std::move(storage), code.size(), fused, std::move(block_starts), std::move(blocks),
+        lazy_jumpdests};
 }
 }  // namespace
 
-CodeAnalysis analyze(zvmc_revision /*rev*/, bytes_view code)
+bool CodeAnalysis::check_jumpdest_lazy(uint64_t position) const noexcept
 {
-    return analyze_legacy(code);
+    const auto pos = static_cast<size_t>(position);
+    const auto word = pos / 64;
+    if (word < m_jumpdest_words || executable_code[pos] != OP_JUMPDEST)
+        return false;
+
+    // The JUMPDEST byte is PUSH data only if one of the 32 preceding bytes is a PUSH opcode
+    // with the data reaching it. If there is none, the far jump is resolved
+    // without analyzing all the code before it.
+    const auto window_begin = pos - std::min(pos, size_t{32});
+    bool maybe_push_data = false;
+    for (auto i = window_begin; i < pos && !maybe_push_data; ++i)
+    {
+        const auto op = executable_code[i];
+        maybe_push_data =
+            op >= OP_PUSH1 && op <= OP_PUSH32 && i + (op - size_t{OP_PUSH1 - 1}) >= pos;
+    }
+    if (!maybe_push_data)
+    {
+        // The bit is the same as the analysis of the word computes later.
+        m_storage[word] |= uint64_t{1} << (pos % 64);
+        return true;
+    }
+
+    // Compute a few more words to amortize the calls for the nearby jump destinations.
+    constexpr size_t lookahead = 4;
+
+    const auto end = std::min(word + lookahead, bitmap_size(executable_code.size()));
+    m_jumpdest_carry = analyze_jumpdests(
+        executable_code, m_storage.get(), m_jumpdest_words, end, m_jumpdest_carry);
+    m_jumpdest_words = end;
+    return (m_storage[word] >> (pos % 64)) & 1;
+}
+
+CodeAnalysis analyze(zvmc_revision rev, bytes_view code, AnalysisOptions options)
+{
+    return analyze_legacy(rev, code, options);
 }
 
 namespace
 {
-/// Checks instruction requirements before execution.
+/// Checks the requirements of the basic block starting at the given position
+/// and charges the base gas cost of all its instructions.
 ///
-/// This checks:
-/// - if the instruction is defined
-/// - if stack height requirements are fulfilled (stack overflow, stack underflow)
-/// - charges the instruction base gas cost and checks is there is any gas left.
+/// Blocks starting with JUMPDEST are checked by the JUMPDEST instruction itself.
+/// Other blocks are checked at the code beginning and after the instructions
+/// ending the block with the fallthrough.
 ///
-/// @tparam         Op            Instruction opcode.
-/// @param          cost_table    Table of base gas costs.
-/// @param [in,out] gas_left      Gas left.
-/// @param          stack_top     Pointer to the stack top item.
-/// @param          stack_bottom  Pointer to the stack bottom.
-///                               The stack height is stack_top - stack_bottom.
 /// @return  Status code with information which check has failed
 ///          or ZVMC_SUCCESS if everything is fine.
-template <Opcode Op>
-inline zvmc_status_code check_requirements(const CostTable& cost_table, int64_t& gas_left,
-    const uint256* stack_top, const uint256* stack_bottom) noexcept
+[[release_inline]] inline zvmc_status_code check_block_requirements(const CodeAnalysis& analysis,
+    code_iterator block_start, int64_t& gas_left, const uint256* stack_top,
+    const uint256* stack_bottom) noexcept
 {
-    static_assert(
-        !instr::has_const_gas_cost(Op) || instr::gas_costs[ZVMC_SHANGHAI][Op] != instr::undefined,
-        "undefined instructions must not be handled by check_requirements()");
+    const auto& block = analysis.block_requirements(
+        static_cast<size_t>(block_start - analysis.executable_code.data()));
 
-    auto gas_cost = instr::gas_costs[ZVMC_SHANGHAI][Op];  // Init assuming const cost.
-    if constexpr (!instr::has_const_gas_cost(Op))
-    {
-        gas_cost = cost_table[Op];  // If not, load the cost from the table.
-
-        // Negative cost marks an undefined instruction.
-        // This check must be first to produce correct error code.
-        if (INTX_UNLIKELY(gas_cost < 0))
-            return ZVMC_UNDEFINED_INSTRUCTION;
-    }
+    if (INTX_UNLIKELY((gas_left -= block.gas_cost) < 0))
+        return ZVMC_OUT_OF_GAS;
 
-    // Check stack requirements first. This is order is not required,
-    // but it is nicer because complete gas check may need to inspect operands.
-    if constexpr (instr::traits[Op].stack_height_change > 0)
-    {
-        static_assert(instr::traits[Op].stack_height_change == 1,
-            "unexpected instruction with multiple results");
-        if (INTX_UNLIKELY(stack_top == stack_bottom + StackSpace::limit))
-            return ZVMC_STACK_OVERFLOW;
-    }
-    if constexpr (instr::traits[Op].stack_height_required > 0)
-    {
-        // Check stack underflow using pointer comparison <= (better optimization).
-        static constexpr auto min_offset = instr::traits[Op].stack_height_required - 1;
-        if (INTX_UNLIKELY(stack_top <= stack_bottom + min_offset))
-            return ZVMC_STACK_UNDERFLOW;
-    }
+    const auto stack_height = stack_top - stack_bottom;
+    if (INTX_UNLIKELY(stack_height < block.stack_req))
+        return ZVMC_STACK_UNDERFLOW;
 
-    if (INTX_UNLIKELY((gas_left -= gas_cost) < 0))
-        return ZVMC_OUT_OF_GAS;
+    if (INTX_UNLIKELY(stack_height + block.stack_max_growth > StackSpace::limit))
+        return ZVMC_STACK_OVERFLOW;
 
     return ZVMC_SUCCESS;
 }
@@ -188,28 +420,116 @@ struct Position
 /// @}
 
 /// A helper to invoke the instruction implementation of the given opcode Op.
-template <Opcode Op>
-[[release_inline]] inline Position invoke(const CostTable& cost_table, const uint256* stack_bottom,
-    Position pos, int64_t& gas, ExecutionState& state) noexcept
+///
+/// In the block checks mode (BlockChecks is true) the instruction requirements are not checked
+/// individually, but the requirements of the whole basic block are checked on the block entry.
+template <Opcode Op, bool BlockChecks, typename CostTableT>
+[[release_inline]] inline Position invoke(const CostTableT& cost_table,
+    const uint256* stack_bottom, Position pos, int64_t& gas, ExecutionState& state) noexcept
 {
-    if (const auto status = check_requirements<Op>(cost_table, gas, pos.stack_top, stack_bottom);
-        status != ZVMC_SUCCESS)
+    if constexpr (is_revision_cost_table<CostTableT>)
+    {
+        // The instruction undefined in the revision known at compile time.
+        if constexpr (CostTableT{}[Op] < 0)
+        {
+            state.status = ZVMC_UNDEFINED_INSTRUCTION;
+            return {nullptr, pos.stack_top};
+        }
+    }
+
+    if constexpr (BlockChecks)
+    {
+        if constexpr (!instr::has_const_gas_cost(Op))
+        {
+            // The undefined instruction ends the block. It is not checked by the block entry.
+            if (INTX_UNLIKELY(cost_table[Op] < 0))
+            {
+                state.status = ZVMC_UNDEFINED_INSTRUCTION;
+                return {nullptr, pos.stack_top};
+            }
+        }
+        if constexpr (Op == OP_JUMPDEST)
+        {
+            if (const auto status = check_block_requirements(
+                    *state.analysis.baseline, pos.code_it, gas, pos.stack_top, stack_bottom);
+                status != ZVMC_SUCCESS)
+            {
+                state.status = status;
+                return {nullptr, pos.stack_top};
+            }
+        }
+    }
+    else if (const auto status =
+                 check_requirements<Op>(cost_table, gas, pos.stack_top, stack_bottom);
+             status != ZVMC_SUCCESS)
     {
         state.status = status;
         return {nullptr, pos.stack_top};
     }
+
     const auto new_pos = invoke(instr::core::impl<Op>, pos, gas, state);
     const auto new_stack_top = pos.stack_top + instr::traits[Op].stack_height_change;
+
+    if constexpr (BlockChecks && is_block_end_with_fallthrough(Op))
+    {
+        // Enter the next block unless it starts with JUMPDEST which checks the block itself.
+        if (new_pos != nullptr && *new_pos != OP_JUMPDEST)
+        {
+            if (const auto status = check_block_requirements(
+                    *state.analysis.baseline, new_pos, gas, new_stack_top, stack_bottom);
+                status != ZVMC_SUCCESS)
+            {
+                state.status = status;
+                return {nullptr, new_stack_top};
+            }
+        }
+    }
     return {new_pos, new_stack_top};
 }
 
+/// A helper to invoke the fused instruction: the instructions of opcodes Ops one after another.
+/// Each instruction is checked as it would be executed separately.
+template <bool BlockChecks, Opcode... Ops, typename CostTableT>
+[[release_inline]] inline Position invoke_fused(const CostTableT& cost_table,
+    const uint256* stack_bottom, Position pos, int64_t& gas, ExecutionState& state) noexcept
+{
+    // Stop at the first instruction which fails or terminates the execution.
+    ((pos = invoke<Ops, BlockChecks>(cost_table, stack_bottom, pos, gas, state),
+         pos.code_it != nullptr) &&
+        ...);
+    return pos;
+}
 
-template <bool TracingEnabled>
-int64_t dispatch(const CostTable& cost_table, ExecutionState& state, int64_t gas,
+/// Enters the first basic block in the block checks mode.
+/// @return  True if the execution can continue.
+inline bool enter_first_block(
+    const uint8_t* code, int64_t& gas, const uint256* stack_bottom, ExecutionState& state) noexcept
+{
+    if (*code == OP_JUMPDEST)  // The JUMPDEST instruction checks the block itself.
+        return true;
+
+    const auto status =
+        check_block_requirements(*state.analysis.baseline, code, gas, stack_bottom, stack_bottom);
+    state.status = status;
+    return status == ZVMC_SUCCESS;
+}
+
+
+template <bool TracingEnabled, bool BlockChecks = false, bool Fused = false,
+    typename CostTableT = CostTable>
+int64_t dispatch(const CostTableT& cost_table, ExecutionState& state, int64_t gas,
     const uint8_t* code, Tracer* tracer = nullptr) noexcept
 {
+    static_assert(!(TracingEnabled && BlockChecks), "tracing requires per-instruction checks");
+
     const auto stack_bottom = state.stack_space.bottom();
 
+    if constexpr (BlockChecks)
+    {
+        if (!enter_first_block(code, gas, stack_bottom, state))
+            return gas;
+    }
+
     // Code iterator and stack top pointer for interpreter loop.
     Position position{code, stack_bottom};
 
@@ -229,24 +549,47 @@ int64_t dispatch(const CostTable& cost_table, ExecutionState& state, int64_t gas
         const auto op = *position.code_it;
         switch (op)
         {
-#define ON_OPCODE(OPCODE)                                                                     \
-    case OPCODE:                                                                              \
-        ASM_COMMENT(OPCODE);                                                                  \
-        if (const auto next = invoke<OPCODE>(cost_table, stack_bottom, position, gas, state); \
-            next.code_it == nullptr)                                                          \
-        {                                                                                     \
-            return gas;                                                                       \
-        }                                                                                     \
-        else                                                                                  \
-        {                                                                                     \
-            /* Update current position only when no error,                                    \
-               this improves compiler optimization. */                                        \
-            position = next;                                                                  \
-        }                                                                                     \
+#define ON_OPCODE(OPCODE)                                                                    \
+    case OPCODE:                                                                             \
+        ASM_COMMENT(OPCODE);                                                                 \
+        if (const auto next =                                                                \
+                invoke<OPCODE, BlockChecks>(cost_table, stack_bottom, position, gas, state); \
+            next.code_it == nullptr)                                                         \
+        {                                                                                    \
+            return gas;                                                                      \
+        }                                                                                    \
+        else                                                                                 \
+        {                                                                                    \
+            /* Update current position only when no error,                                   \
+               this improves compiler optimization. */                                       \
+            position = next;                                                                 \
+        }                                                                                    \
+        break;
+
+#undef ON_OPCODE_FUSED
+#define ON_OPCODE_FUSED(OPCODE, ...)                                       \
+    case OPCODE:                                                           \
+        if constexpr (!Fused)                                              \
+        {                                                                  \
+            state.status = ZVMC_UNDEFINED_INSTRUCTION;                     \
+            return gas;                                                    \
+        }                                                                  \
+        else if (const auto next = invoke_fused<BlockChecks, __VA_ARGS__>( \
+                     cost_table, stack_bottom, position, gas, state);      \
+                 next.code_it == nullptr)                                  \
+        {                                                                  \
+            return gas;                                                    \
+        }                                                                  \
+        else                                                               \
+        {                                                                  \
+            position = next;                                               \
+        }                                                                  \
         break;
 
             MAP_OPCODES
 #undef ON_OPCODE
+#undef ON_OPCODE_FUSED
+#define ON_OPCODE_FUSED ON_OPCODE_FUSED_DEFAULT
 
         default:
             state.status = ZVMC_UNDEFINED_INSTRUCTION;
@@ -257,8 +600,9 @@ int64_t dispatch(const CostTable& cost_table, ExecutionState& state, int64_t gas
 }
 
 #if ZVMONE_CGOTO_SUPPORTED
+template <bool BlockChecks = false, bool Fused = false, typename CostTableT = CostTable>
 int64_t dispatch_cgoto(
-    const CostTable& cost_table, ExecutionState& state, int64_t gas, const uint8_t* code) noexcept
+    const CostTableT& cost_table, ExecutionState& state, int64_t gas, const uint8_t* code) noexcept
 {
 #pragma GCC diagnostic ignored "-Wpedantic"
 
@@ -266,43 +610,431 @@ int64_t dispatch_cgoto(
 #define ON_OPCODE(OPCODE) &&TARGET_##OPCODE,
 #undef ON_OPCODE_UNDEFINED
 #define ON_OPCODE_UNDEFINED(_) &&TARGET_OP_UNDEFINED,
+#undef ON_OPCODE_FUSED
+#define ON_OPCODE_FUSED(OPCODE, ...) Fused ? &&TARGET_FUSED_##OPCODE : &&TARGET_OP_UNDEFINED,
         MAP_OPCODES
 #undef ON_OPCODE
 #undef ON_OPCODE_UNDEFINED
 #define ON_OPCODE_UNDEFINED ON_OPCODE_UNDEFINED_DEFAULT
+#undef ON_OPCODE_FUSED
+#define ON_OPCODE_FUSED ON_OPCODE_FUSED_DEFAULT
     };
     static_assert(std::size(cgoto_table) == 256);
 
     const auto stack_bottom = state.stack_space.bottom();
 
+    if constexpr (BlockChecks)
+    {
+        if (!enter_first_block(code, gas, stack_bottom, state))
+            return gas;
+    }
+
     // Code iterator and stack top pointer for interpreter loop.
     Position position{code, stack_bottom};
 
     goto* cgoto_table[*position.code_it];
 
-#define ON_OPCODE(OPCODE)                                                                 \
-    TARGET_##OPCODE : ASM_COMMENT(OPCODE);                                                \
-    if (const auto next = invoke<OPCODE>(cost_table, stack_bottom, position, gas, state); \
-        next.code_it == nullptr)                                                          \
-    {                                                                                     \
-        return gas;                                                                       \
-    }                                                                                     \
-    else                                                                                  \
-    {                                                                                     \
-        /* Update current position only when no error,                                    \
-           this improves compiler optimization. */                                        \
-        position = next;                                                                  \
-    }                                                                                     \
+#define ON_OPCODE(OPCODE)                                                                \
+    TARGET_##OPCODE : ASM_COMMENT(OPCODE);                                               \
+    if (const auto next =                                                                \
+            invoke<OPCODE, BlockChecks>(cost_table, stack_bottom, position, gas, state); \
+        next.code_it == nullptr)                                                         \
+    {                                                                                    \
+        return gas;                                                                      \
+    }                                                                                    \
+    else                                                                                 \
+    {                                                                                    \
+        /* Update current position only when no error,                                   \
+           this improves compiler optimization. */                                       \
+        position = next;                                                                 \
+    }                                                                                    \
+    goto* cgoto_table[*position.code_it];
+
+#undef ON_OPCODE_FUSED
+#define ON_OPCODE_FUSED(OPCODE, ...)                              \
+    TARGET_FUSED_##OPCODE : ASM_COMMENT(OPCODE);                  \
+    if (const auto next = invoke_fused<BlockChecks, __VA_ARGS__>( \
+            cost_table, stack_bottom, position, gas, state);      \
+        next.code_it == nullptr)                                  \
+    {                                                             \
+        return gas;                                               \
+    }                                                             \
+    else                                                          \
+    {                                                             \
+        position = next;                                          \
+    }                                                             \
     goto* cgoto_table[*position.code_it];
 
     MAP_OPCODES
 #undef ON_OPCODE
+#undef ON_OPCODE_FUSED
+#define ON_OPCODE_FUSED ON_OPCODE_FUSED_DEFAULT
 
 TARGET_OP_UNDEFINED:
     state.status = ZVMC_UNDEFINED_INSTRUCTION;
     return gas;
 }
 #endif
+
+#if ZVMONE_TAILCALL_SUPPORTED
+/// The execution context shared by the handlers of the tail-call threaded interpreter.
+struct TailCallContext
+{
+    const CostTable& cost_table;
+    const uint256* stack_bottom;
+    ExecutionState& state;
+};
+
+/// The handler of the tail-call threaded interpreter. The code position, the stack top and
+/// the gas left are passed as arguments so that they stay in registers between instructions.
+using TailCallHandler = int64_t (*)(
+    code_iterator code_it, uint256* stack_top, int64_t gas, const TailCallContext& ctx) noexcept;
+
+/// The tail-call threaded interpreter: every instruction is a separate function
+/// which executes the instruction and tail-calls the handler of the next one.
+template <bool BlockChecks, bool Fused>
+struct TailCallDispatch
+{
+    /// The handlers indexed by opcode.
+    static const std::array<TailCallHandler, 256> table;
+
+    template <Opcode Op>
+    static int64_t instr(code_iterator code_it, uint256* stack_top, int64_t gas,
+        const TailCallContext& ctx) noexcept
+    {
+        const auto next = invoke<Op, BlockChecks>(
+            ctx.cost_table, ctx.stack_bottom, {code_it, stack_top}, gas, ctx.state);
+        if (next.code_it == nullptr)
+            return gas;
+        [[clang::musttail]] return table[*next.code_it](next.code_it, next.stack_top, gas, ctx);
+    }
+
+    template <Opcode... Ops>
+    static int64_t fused(code_iterator code_it, uint256* stack_top, int64_t gas,
+        const TailCallContext& ctx) noexcept
+    {
+        const auto next = invoke_fused<BlockChecks, Ops...>(
+            ctx.cost_table, ctx.stack_bottom, {code_it, stack_top}, gas, ctx.state);
+        if (next.code_it == nullptr)
+            return gas;
+        [[clang::musttail]] return table[*next.code_it](next.code_it, next.stack_top, gas, ctx);
+    }
+
+    static int64_t undefined(code_iterator /*code_it*/, uint256* /*stack_top*/, int64_t gas,
+        const TailCallContext& ctx) noexcept
+    {
+        ctx.state.status = ZVMC_UNDEFINED_INSTRUCTION;
+        return gas;
+    }
+};
+
+template <bool BlockChecks, bool Fused>
+const std::array<TailCallHandler, 256> TailCallDispatch<BlockChecks, Fused>::table = {
+#define ON_OPCODE(OPCODE) &instr<OPCODE>,
+#undef ON_OPCODE_UNDEFINED
+#define ON_OPCODE_UNDEFINED(_) &undefined,
+#undef ON_OPCODE_FUSED
+#define ON_OPCODE_FUSED(OPCODE, ...) Fused ? &fused<__VA_ARGS__> : &undefined,
+    MAP_OPCODES
+#undef ON_OPCODE
+#undef ON_OPCODE_UNDEFINED
+#define ON_OPCODE_UNDEFINED ON_OPCODE_UNDEFINED_DEFAULT
+#undef ON_OPCODE_FUSED
+#define ON_OPCODE_FUSED ON_OPCODE_FUSED_DEFAULT
+};
+
+template <bool BlockChecks = false, bool Fused = false>
+int64_t dispatch_tailcall(
+    const CostTable& cost_table, ExecutionState& state, int64_t gas, const uint8_t* code) noexcept
+{
+    const auto stack_bottom = state.stack_space.bottom();
+
+    if constexpr (BlockChecks)
+    {
+        if (!enter_first_block(code, gas, stack_bottom, state))
+            return gas;
+    }
+
+    const TailCallContext ctx{cost_table, stack_bottom, state};
+    return TailCallDispatch<BlockChecks, Fused>::table[*code](code, stack_bottom, gas, ctx);
+}
+#endif
+
+#if ZVMONE_JIT_SUPPORTED
+/// The instruction handlers called from the native code compiled by the JIT tier.
+/// The instructions are executed in the block checks mode.
+struct JitHandlers
+{
+    template <Opcode Op>
+    static bool instr(jit::Frame* frame) noexcept
+    {
+        const auto next = invoke<Op, true>(*frame->cost_table, frame->stack_bottom,
+            {frame->code_it, frame->stack_top}, frame->gas, *frame->state);
+        if (next.code_it == nullptr)
+            return false;
+        frame->code_it = next.code_it;
+        frame->stack_top = next.stack_top;
+        return true;
+    }
+
+    static bool undefined(jit::Frame* frame) noexcept
+    {
+        frame->state->status = ZVMC_UNDEFINED_INSTRUCTION;
+        return false;
+    }
+
+    /// Returns the native code address of the instruction at the frame's code position.
+    static const uint8_t* resolve(jit::Frame* frame) noexcept
+    {
+        return frame->native_code + frame->native_offsets[frame->code_it - frame->code];
+    }
+};
+
+/// The JIT instruction handlers indexed by opcode. The fused instructions are not used.
+constexpr std::array<jit::Handler, 256> jit_handlers = {
+#define ON_OPCODE(OPCODE) &JitHandlers::instr<OPCODE>,
+#undef ON_OPCODE_UNDEFINED
+#define ON_OPCODE_UNDEFINED(_) &JitHandlers::undefined,
+#undef ON_OPCODE_FUSED
+#define ON_OPCODE_FUSED(OPCODE, ...) &JitHandlers::undefined,
+    MAP_OPCODES
+#undef ON_OPCODE
+#undef ON_OPCODE_UNDEFINED
+#define ON_OPCODE_UNDEFINED ON_OPCODE_UNDEFINED_DEFAULT
+#undef ON_OPCODE_FUSED
+#define ON_OPCODE_FUSED ON_OPCODE_FUSED_DEFAULT
+};
+
+/// Checks if the instruction can be called directly from the native code with the stack top
+/// pointer: the stack-only instruction with the requirements fully checked by the block entry.
+///
+/// The JUMPDEST is excluded: it is the no-op on the stack, but its handler checks
+/// the requirements of the block it starts. The same applies to the block ends with fallthrough
+/// checking the following block.
+template <Opcode Op>
+constexpr bool is_jit_stack_only() noexcept
+{
+    using StackOnlyFn = void (*)(StackTop) noexcept;
+    return std::is_same_v<std::remove_const_t<decltype(instr::core::impl<Op>)>, StackOnlyFn> &&
+           instr::has_const_gas_cost(Op) && Op != OP_JUMPDEST &&
+           !is_block_end_with_fallthrough(Op);
+}
+
+/// Returns the stack-only implementation of the instruction or null.
+template <Opcode Op>
+constexpr jit::StackFn jit_stack_fn() noexcept
+{
+    if constexpr (is_jit_stack_only<Op>())
+        return [](uint256* stack_top) noexcept { instr::core::impl<Op>(stack_top); };
+    else
+        return nullptr;
+}
+
+/// The stack-only instruction implementations called directly from the native code
+/// indexed by opcode. Null for other instructions.
+constexpr std::array<jit::StackFn, 256> jit_stack_fns = {
+#define ON_OPCODE(OPCODE) jit_stack_fn<OPCODE>(),
+#undef ON_OPCODE_UNDEFINED
+#define ON_OPCODE_UNDEFINED(_) nullptr,
+#undef ON_OPCODE_FUSED
+#define ON_OPCODE_FUSED(OPCODE, ...) nullptr,
+    MAP_OPCODES
+#undef ON_OPCODE
+#undef ON_OPCODE_UNDEFINED
+#define ON_OPCODE_UNDEFINED ON_OPCODE_UNDEFINED_DEFAULT
+#undef ON_OPCODE_FUSED
+#define ON_OPCODE_FUSED ON_OPCODE_FUSED_DEFAULT
+};
+
+/// Loads the big-endian PUSH data of the given size.
+uint256 load_push_value(const uint8_t* data, size_t size) noexcept
+{
+    uint256 value = 0;
+    for (size_t i = 0; i < size; ++i)
+        value = (value << 8) | uint256{data[i]};
+    return value;
+}
+
+/// Compiles the code to the native code of the JIT tier.
+/// Returns null if the executable memory cannot be allocated.
+std::shared_ptr<const jit::CompiledCode> jit_compile(zvmc_revision rev, bytes_view code)
+{
+    auto analysis = analyze(rev, code, {true, false});
+    const auto* const exec_code = analysis.executable_code.data();
+
+    // The instruction may start in the code padding after the truncated PUSH at the code end.
+    std::vector<uint32_t> native_offsets(code.size() + 1 + 32);
+
+    jit::Assembler as;
+    as.prologue();
+    for (size_t i = 0;;)
+    {
+        native_offsets[i] = static_cast<uint32_t>(as.size());
+
+        // The stack-only instructions are defined in all revisions and their requirements
+        // are checked by the block entry so they are emitted as the inline stencils
+        // or the direct calls of their implementations.
+        const auto op = exec_code[i];
+        const auto& tr = instr::traits[op];
+        if (op == OP_POP)
+            as.pop();
+        else if (op >= OP_PUSH1 && op <= OP_PUSH32)
+            as.push(load_push_value(&exec_code[i + 1], tr.immediate_size));
+        else if (op >= OP_DUP1 && op <= OP_DUP16)
+            as.dup(op - OP_DUP1 + 1);
+        else if (op >= OP_SWAP1 && op <= OP_SWAP16)
+            as.swap(op - OP_SWAP1 + 1);
+        else if (op == OP_ADD)
+            as.add();
+        else if (op == OP_SUB)
+            as.sub();
+        else if (op == OP_AND)
+            as.and_();
+        else if (op == OP_OR)
+            as.or_();
+        else if (op == OP_XOR)
+            as.xor_();
+        else if (op == OP_NOT)
+            as.not_();
+        else if (op == OP_ISZERO)
+            as.iszero();
+        else if (op == OP_EQ)
+            as.eq();
+        else if (op == OP_LT)
+            as.lt();
+        else if (op == OP_GT)
+            as.gt();
+        else if (op == OP_SLT)
+            as.slt();
+        else if (op == OP_SGT)
+            as.sgt();
+        else if (jit_stack_fns[op] != nullptr)
+            as.call_stack_fn(jit_stack_fns[op], tr.stack_height_change);
+        else
+        {
+            as.call_handler(jit_handlers[op], &exec_code[i]);
+            if (op == OP_JUMP || op == OP_JUMPI)
+                as.jump_resolved(&JitHandlers::resolve);
+        }
+
+        if (i >= code.size())
+            break;  // The STOP from the code padding has been emitted.
+        i += 1 + size_t{tr.immediate_size};
+    }
+
+    auto native = jit::ExecutableCode::map(as.finish());
+    if (native.empty())
+        return nullptr;
+    return std::make_shared<const jit::CompiledCode>(
+        jit::CompiledCode{std::move(analysis), std::move(native), std::move(native_offsets)});
+}
+
+/// Runs the native code compiled by the JIT tier.
+int64_t dispatch_native(const jit::CompiledCode& compiled, const CostTable& cost_table,
+    ExecutionState& state, int64_t gas) noexcept
+{
+    const auto* const code = compiled.analysis.executable_code.data();
+    const auto stack_bottom = state.stack_space.bottom();
+
+    if (!enter_first_block(code, gas, stack_bottom, state))
+        return gas;
+
+    jit::Frame frame{code, stack_bottom, gas, &state, &cost_table, stack_bottom,
+        compiled.native.data(), compiled.native_offsets.data(), code};
+    compiled.run(frame);
+    return frame.gas;
+}
+#endif
+
+/// The step functions executing the instructions for the ahead-of-time compiled code.
+struct AotSteps
+{
+    template <Opcode Op>
+    static code_iterator instr(const aot::Context& ctx, code_iterator code_it, uint256*& stack_top,
+        int64_t& gas) noexcept
+    {
+        const auto next = invoke<Op, false>(
+            ctx.cost_table, ctx.stack_bottom, {code_it, stack_top}, gas, ctx.state);
+        if (next.code_it != nullptr)
+            stack_top = next.stack_top;
+        return next.code_it;
+    }
+
+    static code_iterator undefined(const aot::Context& ctx, code_iterator /*code_it*/,
+        uint256*& /*stack_top*/, int64_t& /*gas*/) noexcept
+    {
+        ctx.state.status = ZVMC_UNDEFINED_INSTRUCTION;
+        return nullptr;
+    }
+};
+
+/// The AOT step functions indexed by opcode. The fused instructions are not used.
+constexpr std::array<aot::StepFn, 256> aot_steps = {
+#define ON_OPCODE(OPCODE) &AotSteps::instr<OPCODE>,
+#undef ON_OPCODE_UNDEFINED
+#define ON_OPCODE_UNDEFINED(_) &AotSteps::undefined,
+#undef ON_OPCODE_FUSED
+#define ON_OPCODE_FUSED(OPCODE, ...) &AotSteps::undefined,
+    MAP_OPCODES
+#undef ON_OPCODE
+#undef ON_OPCODE_UNDEFINED
+#define ON_OPCODE_UNDEFINED ON_OPCODE_UNDEFINED_DEFAULT
+#undef ON_OPCODE_FUSED
+#define ON_OPCODE_FUSED ON_OPCODE_FUSED_DEFAULT
+};
+
+/// Invokes the function with the cost table of the execution revision as RevisionCostTable.
+/// The revisions without the dedicated instantiation use the runtime cost table.
+template <typename Fn, int... Is>
+int64_t with_revision_cost_table(zvmc_revision rev, const CostTable& cost_table, Fn fn,
+    std::integer_sequence<int, Is...> /*unused*/) noexcept
+{
+    int64_t result = 0;
+    const auto found =
+        ((rev == ZVMC_SHANGHAI + Is ?
+                 (result = fn(RevisionCostTable<static_cast<zvmc_revision>(ZVMC_SHANGHAI + Is)>{}),
+                     true) :
+                 false) ||
+            ...);
+    return found ? result : fn(cost_table);
+}
+
+/// Dispatches the execution without tracing using the interpreter loop selected in the VM.
+template <bool BlockChecks, bool Fused>
+int64_t dispatch_untraced([[maybe_unused]] const VM& vm, const CostTable& cost_table,
+    ExecutionState& state, int64_t gas, const uint8_t* code) noexcept
+{
+#if ZVMONE_TAILCALL_SUPPORTED
+    if (vm.tailcall)
+        return dispatch_tailcall<BlockChecks, Fused>(cost_table, state, gas, code);
+#endif
+
+    // The switch and cgoto loops are instantiated for every revision so the instruction costs
+    // and the undefined instruction checks are resolved at compile time.
+    constexpr auto revisions =
+        std::make_integer_sequence<int, ZVMC_MAX_REVISION - ZVMC_SHANGHAI + 1>{};
+    return with_revision_cost_table(
+        state.rev, cost_table,
+        [&](const auto& table) noexcept {
+#if ZVMONE_CGOTO_SUPPORTED
+            if (vm.cgoto)
+                return dispatch_cgoto<BlockChecks, Fused>(table, state, gas, code);
+#endif
+            return dispatch<false, BlockChecks, Fused>(table, state, gas, code);
+        },
+        revisions);
+}
+
+/// Creates the result of the execution from the final execution state and the gas left.
+zvmc_result make_execution_result(ExecutionState& state, int64_t gas) noexcept
+{
+    const auto gas_left = (state.status == ZVMC_SUCCESS || state.status == ZVMC_REVERT) ? gas : 0;
+    const auto gas_refund = (state.status == ZVMC_SUCCESS) ? state.gas_refund : 0;
+
+    assert(state.output_size != 0 || state.output_offset == 0);
+    return zvmc::make_result(state.status, gas_left, gas_refund,
+        state.output_size != 0 ? &state.memory[state.output_offset] : nullptr, state.output_size);
+}
 }  // namespace
 
 zvmc_result execute(
@@ -317,25 +1049,32 @@ zvmc_result execute(
     auto* tracer = vm.get_tracer();
     if (INTX_UNLIKELY(tracer != nullptr))
     {
-        tracer->notify_execution_start(state.rev, *state.msg, analysis.executable_code);
-        gas = dispatch<true>(cost_table, state, gas, code.data(), tracer);
+        // The fused instructions are traced as their first instruction of the original code.
+        if (analysis.is_fused())
+        {
+            tracer->notify_execution_start(state.rev, *state.msg, state.original_code);
+            gas = dispatch<true, false, true>(cost_table, state, gas, code.data(), tracer);
+        }
+        else
+        {
+            tracer->notify_execution_start(state.rev, *state.msg, analysis.executable_code);
+            gas = dispatch<true>(cost_table, state, gas, code.data(), tracer);
+        }
+    }
+    else if (analysis.has_block_requirements())
+    {
+        gas = analysis.is_fused() ?
+                  dispatch_untraced<true, true>(vm, cost_table, state, gas, code.data()) :
+                  dispatch_untraced<true, false>(vm, cost_table, state, gas, code.data());
     }
     else
     {
-#if ZVMONE_CGOTO_SUPPORTED
-        if (vm.cgoto)
-            gas = dispatch_cgoto(cost_table, state, gas, code.data());
-        else
-#endif
-            gas = dispatch<false>(cost_table, state, gas, code.data());
+        gas = analysis.is_fused() ?
+                  dispatch_untraced<false, true>(vm, cost_table, state, gas, code.data()) :
+                  dispatch_untraced<false, false>(vm, cost_table, state, gas, code.data());
     }
 
-    const auto gas_left = (state.status == ZVMC_SUCCESS || state.status == ZVMC_REVERT) ? gas : 0;
-    const auto gas_refund = (state.status == ZVMC_SUCCESS) ? state.gas_refund : 0;
-
-    assert(state.output_size != 0 || state.output_offset == 0);
-    const auto result = zvmc::make_result(state.status, gas_left, gas_refund,
-        state.output_size != 0 ? &state.memory[state.output_offset] : nullptr, state.output_size);
+    const auto result = make_execution_result(state, gas);
 
     if (INTX_UNLIKELY(tracer != nullptr))
         tracer->notify_execution_end(result);
@@ -343,13 +1082,100 @@ zvmc_result execute(
     return result;
 }
 
+namespace
+{
+/// Returns the code analysis options configured in the VM.
+AnalysisOptions analysis_options(const VM& vm) noexcept
+{
+    // The fused instructions would hide the individual instructions from the tracers.
+    // The lazily analyzed jumpdests must not be shared through the cache.
+    return {vm.block_checks, vm.fusion && vm.get_tracer() == nullptr,
+        vm.lazy_jumpdests && vm.analysis_cache == nullptr};
+}
+
+/// Executes the code in Baseline or in its compiled form.
+zvmc_result execute_baseline(VM* vm, const zvmc_host_interface* host, zvmc_host_context* ctx,
+    zvmc_revision rev, const zvmc_message* msg, bytes_view container) noexcept
+{
+    thread_local ExecutionStatePool<ExecutionState> state_pool;
+    const auto state = state_pool.acquire(*msg, rev, *host, ctx, container);
+    if (vm->keccak_cache)
+    {
+        // The digests are cached for a single transaction started by the depth 0 call.
+        state->keccak_cache = &Keccak256Cache::get_thread_local();
+        if (msg->depth == 0)
+            state->keccak_cache->clear();
+    }
+
+    if (vm->aot_registry != nullptr && vm->get_tracer() == nullptr)
+    {
+        if (const auto* compiled = vm->aot_registry->find(container))
+        {
+            state->analysis.baseline = &compiled->analysis;
+            const aot::Context aot_ctx{*state, get_baseline_cost_table(rev),
+                state->stack_space.bottom(), compiled->analysis.executable_code.data(),
+                aot_steps.data()};
+            return make_execution_result(*state, compiled->fn(aot_ctx, msg->gas));
+        }
+    }
+
+#if ZVMONE_JIT_SUPPORTED
+    if (vm->jit_tier != nullptr && vm->get_tracer() == nullptr)
+    {
+        if (const auto compiled = vm->jit_tier->get(rev, container, jit_compile))
+        {
+            state->analysis.baseline = &compiled->analysis;
+            const auto& cost_table = get_baseline_cost_table(rev);
+            const auto gas_left = dispatch_native(*compiled, cost_table, *state, msg->gas);
+            return make_execution_result(*state, gas_left);
+        }
+    }
+#endif
+
+    // Only the contracts interpreted by Baseline are promoted to Advanced.
+    // The ahead-of-time and JIT compiled ones already run in a faster tier.
+    Tiering<advanced::AdvancedCodeAnalysis>::Entry* tiering_entry = nullptr;
+    if (vm->tiering != nullptr && vm->get_tracer() == nullptr)
+    {
+        const auto [promoted, entry] =
+            vm->tiering->get(rev, container, [](zvmc_revision r, bytes_view c) {
+                return advanced::analyze(r, c);
+            });
+        if (promoted != nullptr)
+            return advanced::execute(*promoted, host, ctx, rev, msg, container);
+        tiering_entry = entry;
+    }
+
+    // The analyses with different options (e.g. unfused for tracing) are cached separately.
+    const auto options = analysis_options(*vm);
+    zvmc_result result{};
+    if (vm->analysis_cache != nullptr)
+    {
+        const auto analysis = vm->analysis_cache->get(
+            rev, container,
+            [options](zvmc_revision r, bytes_view c) { return analyze(r, c, options); },
+            options.bits());
+        result = execute(*vm, msg->gas, *state, *analysis);
+    }
+    else
+    {
+        const auto analysis = analyze(rev, container, options);
+        result = execute(*vm, msg->gas, *state, analysis);
+    }
+
+    if (tiering_entry != nullptr)
+    {
+        const auto gas_used = static_cast<uint64_t>(msg->gas - result.gas_left);
+        vm->tiering->add_gas_used(*tiering_entry, gas_used);
+    }
+    return result;
+}
+}  // namespace
+
 zvmc_result execute(zvmc_vm* c_vm, const zvmc_host_interface* host, zvmc_host_context* ctx,
     zvmc_revision rev, const zvmc_message* msg, const uint8_t* code, size_t code_size) noexcept
 {
     auto vm = static_cast<VM*>(c_vm);
-    const auto jumpdest_map = analyze(rev, {code, code_size});
-    auto state =
-        std::make_unique<ExecutionState>(*msg, rev, *host, ctx, bytes_view{code, code_size});
-    return execute(*vm, msg->gas, *state, jumpdest_map);
+    return execute_baseline(vm, host, ctx, rev, msg, bytes_view{code, code_size});
 }
 }  // namespace zvmone::baseline
@@ -5,6 +5,7 @@
 
 #include <zvmc/utils.h>
 #include <zvmc/zvmc.h>
+#include <bit>
 #include <memory>
 #include <string_view>
 #include <vector>
@@ -18,33 +19,149 @@ class VM;
 
 namespace baseline
 {
+/// The requirements of a basic block checked once at the block entry.
+struct BlockRequirements
+{
+    /// The total base gas cost of all instructions in the block.
+    uint32_t gas_cost = 0;
+
+    /// The stack height required to execute the block.
+    int16_t stack_req = 0;
+
+    /// The maximum stack height growth relative to the stack height at block start.
+    int16_t stack_max_growth = 0;
+};
+static_assert(sizeof(BlockRequirements) == 8);
+
 class CodeAnalysis
 {
 public:
-    using JumpdestMap = std::vector<bool>;
+    /// The word of the bitmap of the basic block start positions.
+    struct BlockStartsWord
+    {
+        uint64_t bits = 0;  ///< The bit i is set if the position 64 * index + i starts a block.
+        uint32_t rank = 0;  ///< The number of blocks starting before this word.
+    };
 
     bytes_view executable_code;  ///< Executable code section.
-    JumpdestMap jumpdest_map;    ///< Map of valid jump destinations.
 
 private:
-    /// Padded code for faster legacy code execution.
-    /// If not nullptr the executable_code must point to it.
-    std::unique_ptr<uint8_t[]> m_padded_code;
+    /// The single allocation containing the bitmap of valid jump destinations
+    /// followed by the padded code. The executable_code points into it.
+    /// The bit (i % 64) of the word (i / 64) is set if the code position i is a valid JUMPDEST.
+    std::unique_ptr<uint64_t[]> m_storage;
+
+    /// The bitmap of the basic block start positions. Empty if the block requirements
+    /// have not been analyzed.
+    std::vector<BlockStartsWord> m_block_starts;
+
+    /// The requirements of the basic blocks in the order of their start positions.
+    std::vector<BlockRequirements> m_blocks;
+
+    /// Whether the executable code contains fused instructions.
+    bool m_fused = false;
+
+    /// The number of the jumpdest bitmap words already computed. Less than the bitmap size
+    /// only if the jumpdests are analyzed lazily, see check_jumpdest_lazy().
+    mutable size_t m_jumpdest_words = 0;
+
+    /// The number of PUSH data bytes continued after the computed jumpdest bitmap words.
+    mutable size_t m_jumpdest_carry = 0;
+
+    /// Checks the jump destination not set in the bitmap. It is invalid unless the bitmap word
+    /// has not been computed yet by the lazy jumpdest analysis.
+    ZVMC_EXPORT bool check_jumpdest_lazy(uint64_t position) const noexcept;
 
 public:
-    CodeAnalysis(std::unique_ptr<uint8_t[]> padded_code, size_t code_size, JumpdestMap map)
-      : executable_code{padded_code.get(), code_size},
-        jumpdest_map{std::move(map)},
-        m_padded_code{std::move(padded_code)}
+    /// Returns the number of 64-bit words of the jumpdest bitmap for the code of the given size.
+    static constexpr size_t bitmap_size(size_t code_size) noexcept { return (code_size + 63) / 64; }
+
+    /// Creates the analysis from the storage of the bitmap followed by the padded code.
+    /// If lazy_jumpdests is true, the zero-initialized bitmap is computed on demand
+    /// by check_jumpdest(). The executable code must not contain fused instructions then.
+    CodeAnalysis(std::unique_ptr<uint64_t[]> storage, size_t code_size, bool fused = false,
+        bool lazy_jumpdests = false) noexcept
+      : executable_code{reinterpret_cast<const uint8_t*>(&storage[bitmap_size(code_size)]),
+            code_size},
+        m_storage{std::move(storage)},
+        m_fused{fused},
+        m_jumpdest_words{lazy_jumpdests ? 0 : bitmap_size(code_size)}
     {}
+
+    /// Creates the analysis also containing the basic block requirements.
+    CodeAnalysis(std::unique_ptr<uint64_t[]> storage, size_t code_size, bool fused,
+        std::vector<BlockStartsWord> block_starts, std::vector<BlockRequirements> blocks,
+        bool lazy_jumpdests = false) noexcept
+      : CodeAnalysis{std::move(storage), code_size, fused, lazy_jumpdests}
+    {
+        m_block_starts = std::move(block_starts);
+        m_blocks = std::move(blocks);
+    }
+
+    /// Checks if the code position is a valid jump destination.
+    /// The position must be less than the code size.
+    ///
+    /// The valid destinations are checked by a single bitmap test. Only the positions not set
+    /// in the bitmap are checked further by the lazy jumpdest analysis, so the eager analysis
+    /// pays nothing for it. The lazy analysis must not be shared between threads.
+    [[nodiscard]] bool check_jumpdest(uint64_t position) const noexcept
+    {
+        return ((m_storage[position / 64] >> (position % 64)) & 1) != 0 ||
+               check_jumpdest_lazy(position);
+    }
+
+    /// Returns true if the jumpdest bitmap is not fully computed yet.
+    [[nodiscard]] bool is_jumpdest_analysis_partial() const noexcept
+    {
+        return m_jumpdest_words < bitmap_size(executable_code.size());
+    }
+
+    /// Returns true if the executable code contains fused instructions.
+    [[nodiscard]] bool is_fused() const noexcept { return m_fused; }
+
+    /// Returns true if the analysis contains the basic block requirements.
+    [[nodiscard]] bool has_block_requirements() const noexcept { return !m_blocks.empty(); }
+
+    /// Returns the requirements of the basic block starting at the given code position.
+    /// The position must be a block start.
+    [[nodiscard]] const BlockRequirements& block_requirements(size_t position) const noexcept
+    {
+        const auto& word = m_block_starts[position / 64];
+        const auto lower_bits = word.bits & ((uint64_t{1} << (position % 64)) - 1);
+        return m_blocks[word.rank + static_cast<size_t>(std::popcount(lower_bits))];
+    }
 };
 static_assert(std::is_move_constructible_v<CodeAnalysis>);
 static_assert(std::is_move_assignable_v<CodeAnalysis>);
 static_assert(!std::is_copy_constructible_v<CodeAnalysis>);
 static_assert(!std::is_copy_assignable_v<CodeAnalysis>);
 
+/// The optional parts of the Baseline code analysis.
+struct AnalysisOptions
+{
+    /// Collect the requirements of basic blocks. The execution then checks the stack
+    /// and charges the base gas cost once per block instead of per instruction.
+    bool block_requirements = false;
+
+    /// Replace common instruction sequences in the executable code with fused instructions.
+    /// See ON_OPCODE_FUSED in instructions_xmacro.hpp.
+    bool fusion = false;
+
+    /// Compute the valid jump destinations lazily on the first jumps instead of the whole code
+    /// upfront. Speeds up the short executions of large code. Not used if any instruction
+    /// has been fused. The analysis must not be shared between threads.
+    bool lazy_jumpdests = false;
+
+    /// Returns the options encoded as the bits of the integer, e.g. for the cache keys.
+    [[nodiscard]] constexpr uint32_t bits() const noexcept
+    {
+        return uint32_t{block_requirements} | uint32_t{fusion} << 1 | uint32_t{lazy_jumpdests} << 2;
+    }
+};
+
 /// Analyze the code to build the bitmap of valid JUMPDEST locations.
-ZVMC_EXPORT CodeAnalysis analyze(zvmc_revision /*rev*/, bytes_view code);
+ZVMC_EXPORT CodeAnalysis analyze(
+    zvmc_revision rev, bytes_view code, AnalysisOptions options = {});
 
 /// Executes in Baseline interpreter using ZVMC-compatible parameters.
 zvmc_result execute(zvmc_vm* vm, const zvmc_host_interface* host, zvmc_host_context* ctx,
@@ -0,0 +1,87 @@
+// zvmone: Fast Zond Virtual Machine implementation
+// Copyright 2026 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "baseline_instruction_table.hpp"
+#include "execution_state.hpp"
+#include "instructions_traits.hpp"
+#include <intx/intx.hpp>
+
+namespace zvmone::baseline
+{
+/// The table of base gas costs of the ZVM revision known at compile time.
+///
+/// Indexing it with the opcode known at compile time gives the constant, so the instruction
+/// costs become immediates and the undefined instruction checks are resolved at compile time.
+template <zvmc_revision Rev>
+struct RevisionCostTable
+{
+    constexpr int16_t operator[](size_t op) const noexcept { return instr::gas_costs[Rev][op]; }
+};
+
+/// Checks if the cost table type is the RevisionCostTable.
+template <typename CostTableT>
+inline constexpr bool is_revision_cost_table = false;
+
+template <zvmc_revision Rev>
+inline constexpr bool is_revision_cost_table<RevisionCostTable<Rev>> = true;
+
+/// Checks instruction requirements before execution.
+///
+/// This checks:
+/// - if the instruction is defined
+/// - if stack height requirements are fulfilled (stack overflow, stack underflow)
+/// - charges the instruction base gas cost and checks is there is any gas left.
+///
+/// @tparam         Op            Instruction opcode.
+/// @tparam         CostTableT    CostTable or RevisionCostTable.
+/// @param          cost_table    Table of base gas costs.
+/// @param [in,out] gas_left      Gas left.
+/// @param          stack_top     Pointer to the stack top item.
+/// @param          stack_bottom  Pointer to the stack bottom.
+///                               The stack height is stack_top - stack_bottom.
+/// @return  Status code with information which check has failed
+///          or ZVMC_SUCCESS if everything is fine.
+template <Opcode Op, typename CostTableT = CostTable>
+inline zvmc_status_code check_requirements(const CostTableT& cost_table, int64_t& gas_left,
+    const uint256* stack_top, const uint256* stack_bottom) noexcept
+{
+    static_assert(
+        !instr::has_const_gas_cost(Op) || instr::gas_costs[ZVMC_SHANGHAI][Op] != instr::undefined,
+        "undefined instructions must not be handled by check_requirements()");
+
+    auto gas_cost = instr::gas_costs[ZVMC_SHANGHAI][Op];  // Init assuming const cost.
+    if constexpr (!instr::has_const_gas_cost(Op))
+    {
+        gas_cost = cost_table[Op];  // If not, load the cost from the table.
+
+        // Negative cost marks an undefined instruction.
+        // This check must be first to produce correct error code.
+        if (INTX_UNLIKELY(gas_cost < 0))
+            return ZVMC_UNDEFINED_INSTRUCTION;
+    }
+
+    // Check stack requirements first. This is order is not required,
+    // but it is nicer because complete gas check may need to inspect operands.
+    if constexpr (instr::traits[Op].stack_height_change > 0)
+    {
+        static_assert(instr::traits[Op].stack_height_change == 1,
+            "unexpected instruction with multiple results");
+        if (INTX_UNLIKELY(stack_top == stack_bottom + StackSpace::limit))
+            return ZVMC_STACK_OVERFLOW;
+    }
+    if constexpr (instr::traits[Op].stack_height_required > 0)
+    {
+        // Check stack underflow using pointer comparison <= (better optimization).
+        static constexpr auto min_offset = instr::traits[Op].stack_height_required - 1;
+        if (INTX_UNLIKELY(stack_top <= stack_bottom + min_offset))
+            return ZVMC_STACK_UNDERFLOW;
+    }
+
+    if (INTX_UNLIKELY((gas_left -= gas_cost) < 0))
+        return ZVMC_OUT_OF_GAS;
+
+    return ZVMC_SUCCESS;
+}
+}  // namespace zvmone::baseline
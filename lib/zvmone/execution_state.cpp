@@ -0,0 +1,38 @@
+// zvmone: Fast Zond Virtual Machine implementation
+// Copyright 2026 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "execution_state.hpp"
+
+#if ZVMONE_MEMORY_MMAP
+#include <sys/mman.h>
+
+namespace zvmone
+{
+uint8_t* Memory::remap(uint8_t* data, size_t size, size_t new_size) noexcept
+{
+    void* ptr = MAP_FAILED;
+#if defined(__linux__)
+    if (data != nullptr)
+        ptr = mremap(data, size, new_size, MREMAP_MAYMOVE);
+    else
+#endif
+    {
+        // The pages are committed on the first access so the swap space is not reserved.
+        ptr = mmap(nullptr, new_size, PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (ptr != MAP_FAILED && data != nullptr)
+        {
+            std::memcpy(ptr, data, size);
+            munmap(data, size);
+        }
+    }
+    return ptr != MAP_FAILED ? static_cast<uint8_t*>(ptr) : nullptr;
+}
+
+void Memory::unmap(uint8_t* data, size_t size) noexcept
+{
+    munmap(data, size);
+}
+}  // namespace zvmone
+#endif
@@ -3,21 +3,32 @@
 // SPDX-License-Identifier: Apache-2.0
 #pragma once
 
+#include "arithmetic.hpp"
 #include <intx/intx.hpp>
 #include <zvmc/zvmc.hpp>
+#include <algorithm>
+#include <cassert>
+#include <cstring>
 #include <string>
 #include <vector>
 
+#ifndef ZVMONE_MEMORY_MMAP
+/// Back the ZVM memory with the anonymous memory mappings instead of the heap allocations.
+#define ZVMONE_MEMORY_MMAP 0
+#endif
+
 namespace zvmone
 {
 namespace advanced
 {
 struct AdvancedCodeAnalysis;
+struct CompactCodeAnalysis;
 }
 namespace baseline
 {
 class CodeAnalysis;
 }
+class Keccak256Cache;
 
 using uint256 = intx::uint256;
 using bytes = std::basic_string<uint8_t>;
@@ -48,6 +59,11 @@ private:
 ///
 /// The implementations uses initial allocation of 4k and then grows capacity with 2x factor.
 /// Some benchmarks has been done to confirm 4k is ok-ish value.
+///
+/// With ZVMONE_MEMORY_MMAP the memory is an anonymous mapping instead. Its pages are committed
+/// by the OS on the first access and are initially zero, so only the bytes left non-zero
+/// by the previous execution are cleared. On Linux the mapping grows with mremap()
+/// which moves the pages without copying them.
 class Memory
 {
     /// The size of allocation "page".
@@ -60,23 +76,53 @@ class Memory
     size_t m_size = 0;
 
     /// The size of allocated memory. The initialization value is the initial capacity.
-    size_t m_capacity = page_size;
+    /// The mapping starts larger because its untouched pages cost nothing.
+    size_t m_capacity = ZVMONE_MEMORY_MMAP ? 16 * page_size : page_size;
+
+    /// The size of the prefix of the allocated memory which may contain non-zero bytes.
+    /// The rest is known to be zero and is not cleared when the memory grows.
+    size_t m_dirty_size = 0;
 
     [[noreturn, gnu::cold]] static void handle_out_of_memory() noexcept { std::terminate(); }
 
-    void allocate_capacity() noexcept
+#if ZVMONE_MEMORY_MMAP
+    /// Resizes the mapping of the given size (creates it if null) to the new size.
+    /// The added pages are zero. Returns null on failure.
+    ZVMC_EXPORT static uint8_t* remap(uint8_t* data, size_t size, size_t new_size) noexcept;
+
+    /// Unmaps the mapping of the given size.
+    ZVMC_EXPORT static void unmap(uint8_t* data, size_t size) noexcept;
+#endif
+
+    void allocate_capacity([[maybe_unused]] size_t old_capacity) noexcept
     {
+#if ZVMONE_MEMORY_MMAP
+        m_data = remap(m_data, old_capacity, m_capacity);
+        if (m_data == nullptr)
+            handle_out_of_memory();
+#else
         m_data = static_cast<uint8_t*>(std::realloc(m_data, m_capacity));
         if (m_data == nullptr)
             handle_out_of_memory();
+        m_dirty_size = m_capacity;  // The reallocated memory is not initialized.
+#endif
+    }
+
+    static void free_capacity(uint8_t* data, [[maybe_unused]] size_t capacity) noexcept
+    {
+#if ZVMONE_MEMORY_MMAP
+        unmap(data, capacity);
+#else
+        std::free(data);
+#endif
     }
 
 public:
     /// Creates Memory object with initial capacity allocation.
-    Memory() noexcept { allocate_capacity(); }
+    Memory() noexcept { allocate_capacity(0); }
 
     /// Frees all allocated memory.
-    ~Memory() noexcept { std::free(m_data); }
+    ~Memory() noexcept { free_capacity(m_data, m_capacity); }
 
     Memory(const Memory&) = delete;
     Memory& operator=(const Memory&) = delete;
@@ -85,6 +131,7 @@ public:
 
     [[nodiscard]] const uint8_t* data() const noexcept { return m_data; }
     [[nodiscard]] size_t size() const noexcept { return m_size; }
+    [[nodiscard]] size_t capacity() const noexcept { return m_capacity; }
 
     /// Grows the memory to the given size. The extend is filled with zeros.
     ///
@@ -99,6 +146,7 @@ public:
 
         if (new_size > m_capacity)
         {
+            const auto old_capacity = m_capacity;
             m_capacity *= 2;  // Double the capacity.
 
             if (m_capacity < new_size)  // If not enough.
@@ -107,10 +155,12 @@ public:
                 m_capacity = ((new_size + (page_size - 1)) / page_size) * page_size;
             }
 
-            allocate_capacity();
+            allocate_capacity(old_capacity);
         }
-        std::memset(m_data + m_size, 0, new_size - m_size);
+        if (m_dirty_size > m_size)
+            std::memset(m_data + m_size, 0, std::min(new_size, m_dirty_size) - m_size);
         m_size = new_size;
+        m_dirty_size = std::max(m_dirty_size, new_size);
     }
 
     /// Virtually clears the memory by setting its size to 0. The capacity stays unchanged.
@@ -148,10 +198,17 @@ public:
     {
         const baseline::CodeAnalysis* baseline = nullptr;
         const advanced::AdvancedCodeAnalysis* advanced;
+        const advanced::CompactCodeAnalysis* advanced_compact;
     } analysis{};
 
     std::vector<const uint8_t*> call_stack;
 
+    /// The precomputed reductions for the MULMOD moduli repeated in this execution.
+    arith::ModulusCache mulmod_cache;
+
+    /// The cache of the KECCAK256 digests shared by the transaction executions. Disabled if null.
+    Keccak256Cache* keccak_cache = nullptr;
+
     /// Stack space allocation.
     ///
     /// This is the last field to make other fields' offsets of reasonable values.
@@ -181,6 +238,8 @@ public:
         output_offset = 0;
         output_size = 0;
         m_tx = {};
+        mulmod_cache.clear();
+        keccak_cache = nullptr;
     }
 
     [[nodiscard]] bool in_static_mode() const { return (msg->flags & ZVMC_STATIC) != 0; }
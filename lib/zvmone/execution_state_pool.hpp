@@ -0,0 +1,124 @@
+// zvmone: Fast Zond Virtual Machine implementation
+// Copyright 2026 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "execution_state.hpp"
+#include <memory>
+#include <vector>
+
+namespace zvmone
+{
+/// The pool of reusable execution states indexed by the call depth.
+///
+/// Each call depth has at most one idle state. Reusing it avoids the allocation of the stack space
+/// and the memory, and keeps their pages warm for the nested calls. The total size of the idle
+/// states is limited by max_retained_bytes. The pool is not thread-safe and is intended to be used
+/// as a thread_local object.
+template <typename StateT>
+class ExecutionStatePool
+{
+    /// The idle states. The null slot means the state has not been created yet
+    /// or is currently leased.
+    std::vector<std::unique_ptr<StateT>> m_slots;
+
+    /// The total size of the idle states.
+    size_t m_retained_bytes = 0;
+
+public:
+    /// The maximum call depth for which the states are pooled.
+    static constexpr size_t max_depth = 1024;
+
+    /// The maximum memory capacity of a state which is returned to the pool.
+    /// The states which have grown larger memory are freed so that a single memory-hungry call
+    /// does not keep the large allocation for the lifetime of the thread.
+    static constexpr size_t max_retained_memory = 1024 * 1024;
+
+    /// The maximum total size of the idle states, including their memory capacity.
+    ///
+    /// A state takes about 33 KiB of which 32 KiB is the stack space. Without the limit a thread
+    /// which once reached the maximum call depth would keep about 1 GiB in the pool.
+    /// The limit keeps around 200 states with small memory, far more than the call depth
+    /// of the typical transactions.
+    static constexpr size_t max_retained_bytes = 8 * 1024 * 1024;
+
+    /// The execution state leased from the pool. Returns the state to the pool on destruction.
+    class Lease
+    {
+        ExecutionStatePool* m_pool = nullptr;
+        size_t m_depth = 0;
+        std::unique_ptr<StateT> m_state;
+
+    public:
+        Lease(ExecutionStatePool& pool, size_t depth, std::unique_ptr<StateT> state) noexcept
+          : m_pool{&pool}, m_depth{depth}, m_state{std::move(state)}
+        {}
+
+        ~Lease() noexcept { m_pool->release(m_depth, std::move(m_state)); }
+
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        StateT& operator*() const noexcept { return *m_state; }
+        StateT* operator->() const noexcept { return m_state.get(); }
+        StateT* get() const noexcept { return m_state.get(); }
+    };
+
+    /// Takes the idle state for the message's depth and resets it for the new execution.
+    /// Creates a new state if there is no idle one, e.g. when the depth is already in use
+    /// by a reentrant execution on the same thread.
+    [[nodiscard]] Lease acquire(const zvmc_message& message, zvmc_revision revision,
+        const zvmc_host_interface& host_interface, zvmc_host_context* host_ctx,
+        bytes_view code) noexcept
+    {
+        const auto depth = static_cast<size_t>(message.depth);
+        if (depth < m_slots.size() && m_slots[depth] != nullptr)
+        {
+            auto state = std::move(m_slots[depth]);
+            m_retained_bytes -= retained_size(*state);
+            state->reset(message, revision, host_interface, host_ctx, code);
+            return {*this, depth, std::move(state)};
+        }
+        return {*this, depth,
+            std::make_unique<StateT>(message, revision, host_interface, host_ctx, code)};
+    }
+
+    /// Returns the number of idle states in the pool.
+    [[nodiscard]] size_t num_idle() const noexcept
+    {
+        size_t n = 0;
+        for (const auto& s : m_slots)
+            n += (s != nullptr);
+        return n;
+    }
+
+    /// Returns the total size of the idle states in the pool.
+    [[nodiscard]] size_t retained_bytes() const noexcept { return m_retained_bytes; }
+
+private:
+    static size_t retained_size(const StateT& state) noexcept
+    {
+        return sizeof(StateT) + state.memory.capacity();
+    }
+
+    void release(size_t depth, std::unique_ptr<StateT> state) noexcept
+    {
+        if (depth > max_depth || state->memory.capacity() > max_retained_memory)
+            return;
+
+        const auto size = retained_size(*state);
+        if (m_retained_bytes + size > max_retained_bytes)
+            return;
+
+        if (depth >= m_slots.size())
+            m_slots.resize(depth + 1);
+
+        // Keep the already idle state if the depth has been reentered.
+        if (m_slots[depth] == nullptr)
+        {
+            m_slots[depth] = std::move(state);
+            m_retained_bytes += size;
+        }
+    }
+};
+}  // namespace zvmone
@@ -3,12 +3,25 @@
 // SPDX-License-Identifier: Apache-2.0
 #pragma once
 
+#include "arithmetic.hpp"
 #include "baseline.hpp"
 #include "execution_state.hpp"
 #include "instructions_traits.hpp"
 #include "instructions_xmacro.hpp"
+#include "keccak_cache.hpp"
 #include <ethash/keccak.hpp>
 
+#ifndef ZVMONE_AVX2_INSTRUCTIONS
+#define ZVMONE_AVX2_INSTRUCTIONS 0
+#endif
+
+#if ZVMONE_AVX2_INSTRUCTIONS
+#ifndef __AVX2__
+#error "ZVMONE_AVX2_INSTRUCTIONS requires the AVX2 target (ZVMONE_X86_64_ARCH_LEVEL >= 3)"
+#endif
+#include <immintrin.h>
+#endif
+
 namespace zvmone
 {
 using code_iterator = const uint8_t*;
@@ -162,25 +175,25 @@ inline void sub(StackTop stack) noexcept
 inline void div(StackTop stack) noexcept
 {
     auto& v = stack[1];
-    v = v != 0 ? stack[0] / v : 0;
+    v = v != 0 ? arith::div(stack[0], v) : 0;
 }
 
 inline void sdiv(StackTop stack) noexcept
 {
     auto& v = stack[1];
-    v = v != 0 ? intx::sdivrem(stack[0], v).quot : 0;
+    v = v != 0 ? arith::sdiv(stack[0], v) : 0;
 }
 
 inline void mod(StackTop stack) noexcept
 {
     auto& v = stack[1];
-    v = v != 0 ? stack[0] % v : 0;
+    v = v != 0 ? arith::mod(stack[0], v) : 0;
 }
 
 inline void smod(StackTop stack) noexcept
 {
     auto& v = stack[1];
-    v = v != 0 ? intx::sdivrem(stack[0], v).rem : 0;
+    v = v != 0 ? arith::smod(stack[0], v) : 0;
 }
 
 inline void addmod(StackTop stack) noexcept
@@ -188,15 +201,15 @@ inline void addmod(StackTop stack) noexcept
     const auto& x = stack.pop();
     const auto& y = stack.pop();
     auto& m = stack.top();
-    m = m != 0 ? intx::addmod(x, y, m) : 0;
+    m = m != 0 ? arith::addmod(x, y, m) : 0;
 }
 
-inline void mulmod(StackTop stack) noexcept
+inline void mulmod(StackTop stack, ExecutionState& state) noexcept
 {
     const auto& x = stack[0];
     const auto& y = stack[1];
     auto& m = stack[2];
-    m = m != 0 ? intx::mulmod(x, y, m) : 0;
+    m = m != 0 ? arith::mulmod(x, y, m, state.mulmod_cache) : 0;
 }
 
 inline Result exp(StackTop stack, int64_t gas_left, ExecutionState& /*state*/) noexcept
@@ -211,7 +224,7 @@ inline Result exp(StackTop stack, int64_t gas_left, ExecutionState& /*state*/) n
     if ((gas_left -= additional_cost) < 0)
         return {ZVMC_OUT_OF_GAS, gas_left};
 
-    exponent = intx::exp(base, exponent);
+    exponent = arith::exp(base, exponent);
     return {ZVMC_SUCCESS, gas_left};
 }
 
@@ -272,6 +285,55 @@ inline void sgt(StackTop stack) noexcept
     stack[0] = slt(stack[0], x);  // Arguments are swapped and SLT is used.
 }
 
+#if ZVMONE_AVX2_INSTRUCTIONS
+/// Loads the stack item to the AVX2 register.
+///
+/// The unaligned load is used because the items are not always in the stack space:
+/// the Baseline top caching passes the local copies. For the stack items aligned
+/// to 32 bytes it is as fast as the aligned one.
+inline __m256i load_ymm(const uint256& x) noexcept
+{
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&x));
+}
+
+/// Stores the AVX2 register to the stack item.
+inline void store_ymm(uint256& x, __m256i v) noexcept
+{
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&x), v);
+}
+
+inline void eq(StackTop stack) noexcept
+{
+    const auto d = _mm256_xor_si256(load_ymm(stack[0]), load_ymm(stack[1]));
+    stack[1] = _mm256_testz_si256(d, d) != 0;
+}
+
+inline void iszero(StackTop stack) noexcept
+{
+    const auto x = load_ymm(stack.top());
+    stack.top() = _mm256_testz_si256(x, x) != 0;
+}
+
+inline void and_(StackTop stack) noexcept
+{
+    store_ymm(stack[1], _mm256_and_si256(load_ymm(stack[0]), load_ymm(stack[1])));
+}
+
+inline void or_(StackTop stack) noexcept
+{
+    store_ymm(stack[1], _mm256_or_si256(load_ymm(stack[0]), load_ymm(stack[1])));
+}
+
+inline void xor_(StackTop stack) noexcept
+{
+    store_ymm(stack[1], _mm256_xor_si256(load_ymm(stack[0]), load_ymm(stack[1])));
+}
+
+inline void not_(StackTop stack) noexcept
+{
+    store_ymm(stack.top(), _mm256_xor_si256(load_ymm(stack.top()), _mm256_set1_epi64x(-1)));
+}
+#else
 inline void eq(StackTop stack) noexcept
 {
     stack[1] = stack[0] == stack[1];
@@ -301,6 +363,7 @@ inline void not_(StackTop stack) noexcept
 {
     stack.top() = ~stack.top();
 }
+#endif
 
 inline void byte(StackTop stack) noexcept
 {
@@ -355,7 +418,10 @@ inline Result keccak256(StackTop stack, int64_t gas_left, ExecutionState& state)
         return {ZVMC_OUT_OF_GAS, gas_left};
 
     auto data = s != 0 ? &state.memory[i] : nullptr;
-    size = intx::be::load<uint256>(ethash::keccak256(data, s));
+    if (state.keccak_cache != nullptr && s != 0 && s <= Keccak256Cache::max_input_size)
+        size = intx::be::load<uint256>(state.keccak_cache->keccak256(data, s));
+    else
+        size = intx::be::load<uint256>(ethash::keccak256(data, s));
     return {ZVMC_SUCCESS, gas_left};
 }
 
@@ -685,14 +751,15 @@ Result sstore(StackTop stack, int64_t gas_left, ExecutionState& state) noexcept;
 /// Internal jump implementation for JUMP/JUMPI instructions.
 inline code_iterator jump_impl(ExecutionState& state, const uint256& dst) noexcept
 {
-    const auto& jumpdest_map = state.analysis.baseline->jumpdest_map;
-    if (dst >= jumpdest_map.size() || !jumpdest_map[static_cast<size_t>(dst)])
+    const auto& analysis = *state.analysis.baseline;
+    if (dst >= analysis.executable_code.size() ||
+        !analysis.check_jumpdest(static_cast<uint64_t>(dst)))
     {
         state.status = ZVMC_BAD_JUMP_DESTINATION;
         return nullptr;
     }
 
-    return &state.analysis.baseline->executable_code[static_cast<size_t>(dst)];
+    return &analysis.executable_code[static_cast<size_t>(dst)];
 }
 
 /// JUMP instruction implementation using baseline::CodeAnalysis.
@@ -803,7 +870,11 @@ template <int N>
 inline void dup(StackTop stack) noexcept
 {
     static_assert(N >= 1 && N <= 16);
+#if ZVMONE_AVX2_INSTRUCTIONS
+    store_ymm(stack[-1], load_ymm(stack[N - 1]));
+#else
     stack.push(stack[N - 1]);
+#endif
 }
 
 /// SWAP instruction implementation.
@@ -813,6 +884,11 @@ inline void swap(StackTop stack) noexcept
 {
     static_assert(N >= 1 && N <= 16);
 
+#if ZVMONE_AVX2_INSTRUCTIONS
+    const auto a = load_ymm(stack[N]);
+    store_ymm(stack[N], load_ymm(stack.top()));
+    store_ymm(stack.top(), a);
+#else
     // The simple std::swap(stack.top(), stack[N]) is not used to workaround
     // clang missed optimization: https://github.com/llvm/llvm-project/issues/59116
     // TODO(clang): Check if #59116 bug fix has been released.
@@ -828,6 +904,7 @@ inline void swap(StackTop stack) noexcept
     a[1] = t1;
     a[2] = t2;
     a[3] = t3;
+#endif
 }
 
 template <size_t NumTopics>
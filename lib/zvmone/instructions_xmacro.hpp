@@ -9,15 +9,20 @@
 /// The default macro for ON_OPCODE_UNDEFINED. Empty implementation to ignore undefined opcodes.
 #define ON_OPCODE_UNDEFINED_DEFAULT(OPCODE)
 
+/// The default macro for ON_OPCODE_FUSED. It redirects to ON_OPCODE_UNDEFINED
+/// because the fused opcodes are undefined ZVM instructions.
+#define ON_OPCODE_FUSED_DEFAULT(OPCODE, ...) ON_OPCODE_UNDEFINED(OPCODE)
+
 
 #define ON_OPCODE_IDENTIFIER ON_OPCODE_IDENTIFIER_DEFAULT
 #define ON_OPCODE_UNDEFINED ON_OPCODE_UNDEFINED_DEFAULT
+#define ON_OPCODE_FUSED ON_OPCODE_FUSED_DEFAULT
 
 
 /// The "X Macro" for opcodes and their matching identifiers.
 ///
 /// The MAP_OPCODES is an extended variant of X Macro idiom.
-/// It has 3 knobs for users.
+/// It has 4 knobs for users.
 ///
 /// 1. The ON_OPCODE(OPCODE) macro must be defined. It will receive all defined opcodes from
 ///    the zvmc_opcode enum.
@@ -29,6 +34,12 @@
 ///    the pairs of all defined opcodes and their matching identifiers.
 ///    This macro is by default alias to ON_OPCODE_IDENTIFIER_DEFAULT therefore users must first
 ///    undef it and restore the alias after usage.
+/// 4. The ON_OPCODE_FUSED(OPCODE, OPCODES...) macro may be defined to receive the undefined
+///    opcodes used by the Baseline interpreter for fused instructions (superinstructions)
+///    and the sequences of opcodes they replace. By default these are passed
+///    to ON_OPCODE_UNDEFINED. This macro is by default alias to ON_OPCODE_FUSED_DEFAULT
+///    therefore users must first undef it and restore the alias after usage.
+///    The fused instructions can be selected with test/internal_benchmarks/fused_opcodes.py.
 ///
 /// See for more about X Macros: https://en.wikipedia.org/wiki/X_Macro.
 #define MAP_OPCODES                                         \
@@ -219,14 +230,14 @@
     ON_OPCODE_UNDEFINED(0xae)                               \
     ON_OPCODE_UNDEFINED(0xaf)                               \
                                                             \
-    ON_OPCODE_UNDEFINED(0xb0)                               \
-    ON_OPCODE_UNDEFINED(0xb1)                               \
-    ON_OPCODE_UNDEFINED(0xb2)                               \
-    ON_OPCODE_UNDEFINED(0xb3)                               \
-    ON_OPCODE_UNDEFINED(0xb4)                               \
-    ON_OPCODE_UNDEFINED(0xb5)                               \
-    ON_OPCODE_UNDEFINED(0xb6)                               \
-    ON_OPCODE_UNDEFINED(0xb7)                               \
+    ON_OPCODE_FUSED(0xb0, OP_PUSH1, OP_ADD)                 \
+    ON_OPCODE_FUSED(0xb1, OP_PUSH1, OP_MLOAD)               \
+    ON_OPCODE_FUSED(0xb2, OP_DUP2, OP_DUP2, OP_LT)          \
+    ON_OPCODE_FUSED(0xb3, OP_SWAP1, OP_POP)                 \
+    ON_OPCODE_FUSED(0xb4, OP_POP, OP_POP)                   \
+    ON_OPCODE_FUSED(0xb5, OP_PUSH2, OP_JUMP)                \
+    ON_OPCODE_FUSED(0xb6, OP_PUSH2, OP_JUMPI)               \
+    ON_OPCODE_FUSED(0xb7, OP_ISZERO, OP_PUSH2, OP_JUMPI)    \
     ON_OPCODE_UNDEFINED(0xb8)                               \
     ON_OPCODE_UNDEFINED(0xb9)                               \
     ON_OPCODE_UNDEFINED(0xba)                               \
@@ -0,0 +1,43 @@
+// zvmone: Fast Zond Virtual Machine implementation
+// Copyright 2026 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "jit.hpp"
+
+#if ZVMONE_JIT_SUPPORTED
+#include <sys/mman.h>
+#endif
+
+namespace zvmone::jit
+{
+ExecutableCode::~ExecutableCode()
+{
+#if ZVMONE_JIT_SUPPORTED
+    if (m_data != nullptr)
+        munmap(m_data, m_size);
+#endif
+}
+
+ExecutableCode ExecutableCode::map([[maybe_unused]] const std::vector<uint8_t>& code) noexcept
+{
+#if ZVMONE_JIT_SUPPORTED
+    // The memory is mapped writable for copying the code and then switched to executable
+    // so that it is never writable and executable at the same time.
+    const auto size = code.size();
+    auto* const ptr =
+        mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ptr == MAP_FAILED)
+        return {};
+
+    std::memcpy(ptr, code.data(), size);
+    if (mprotect(ptr, size, PROT_READ | PROT_EXEC) != 0)
+    {
+        munmap(ptr, size);
+        return {};
+    }
+    return {static_cast<uint8_t*>(ptr), size};
+#else
+    return {};
+#endif
+}
+}  // namespace zvmone::jit
@@ -0,0 +1,520 @@
+// zvmone: Fast Zond Virtual Machine implementation
+// Copyright 2026 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "analysis_cache.hpp"
+#include "baseline.hpp"
+#include "baseline_instruction_table.hpp"
+#include <intx/intx.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#if defined(__x86_64__) && defined(__linux__)
+#define ZVMONE_JIT_SUPPORTED 1
+#else
+#define ZVMONE_JIT_SUPPORTED 0
+#endif
+
+namespace zvmone
+{
+class ExecutionState;
+}
+
+/// The template JIT tier of Baseline.
+///
+/// The code is translated to the x86-64 native code instruction by instruction. The stack
+/// manipulation (POP, PUSH, DUP, SWAP), the bitwise (AND, OR, XOR, NOT), the comparison
+/// (LT, GT, SLT, SGT, EQ, ISZERO), ADD and SUB instructions are emitted as inline stencils
+/// operating on the stack top pointer kept in a register. The other stack-only instructions
+/// (e.g. MUL, DIV, SHL) are emitted as direct calls of their implementations with the stack top
+/// pointer. The remaining instructions, using the execution state, are emitted as calls
+/// to the handlers executing the Baseline instruction implementations. The stack and gas
+/// requirements are checked once per basic block as in the Baseline block checks mode.
+namespace zvmone::jit
+{
+using uint256 = intx::uint256;
+
+/// The state of the native code execution. The native code keeps the pointer to it
+/// in the callee-saved register and passes it to the instruction handlers.
+struct Frame
+{
+    /// The code position of the instruction being executed. Set by the native code
+    /// before a handler is called and updated by the control flow handlers.
+    const uint8_t* code_it;
+
+    /// The stack top pointer. Stored by the native code before a handler is called
+    /// and reloaded after it.
+    uint256* stack_top;
+
+    int64_t gas;  ///< The gas left.
+
+    ExecutionState* state;
+    const baseline::CostTable* cost_table;
+    const uint256* stack_bottom;
+
+    /// The beginning of the native code.
+    const uint8_t* native_code;
+
+    /// The native code offsets of the instructions indexed by the code position.
+    const uint32_t* native_offsets;
+
+    /// The beginning of the executable code.
+    const uint8_t* code;
+};
+static_assert(offsetof(Frame, code_it) == 0);
+static_assert(offsetof(Frame, stack_top) == 8);
+
+/// The instruction handler called from the native code.
+/// @return  True if the execution continues.
+using Handler = bool (*)(Frame* frame) noexcept;
+
+/// The handler returning the native code address of the frame's code position.
+using Resolver = const uint8_t* (*)(Frame* frame) noexcept;
+
+/// The stack-only instruction implementation called directly from the native code
+/// with the stack top pointer.
+using StackFn = void (*)(uint256* stack_top) noexcept;
+
+/// The x86-64 machine code emitter of the instruction stencils.
+///
+/// The native code runs with the Frame pointer in RBX and the stack top pointer in R12.
+class Assembler
+{
+    std::vector<uint8_t> m_code;
+
+    /// The positions of the rel32 operands of the jumps to the epilogue.
+    std::vector<size_t> m_exit_jumps;
+
+    void emit(std::initializer_list<uint8_t> bytes) { m_code.insert(m_code.end(), bytes); }
+
+    void emit32(int32_t value)
+    {
+        uint8_t bytes[sizeof(value)];
+        std::memcpy(bytes, &value, sizeof(value));
+        m_code.insert(m_code.end(), std::begin(bytes), std::end(bytes));
+    }
+
+    void emit64(uint64_t value)
+    {
+        uint8_t bytes[sizeof(value)];
+        std::memcpy(bytes, &value, sizeof(value));
+        m_code.insert(m_code.end(), std::begin(bytes), std::end(bytes));
+    }
+
+    /// mov rax, imm64
+    void mov_rax(uint64_t value)
+    {
+        emit({0x48, 0xb8});
+        emit64(value);
+    }
+
+    void mov_rax(const void* ptr) { mov_rax(reinterpret_cast<uintptr_t>(ptr)); }
+
+    /// movdqu xmm<reg>, [r12 + disp] or movdqu [r12 + disp], xmm<reg>.
+    void movdqu(bool store, uint8_t reg, int32_t disp)
+    {
+        emit({0xf3, 0x41, 0x0f, uint8_t(store ? 0x7f : 0x6f), uint8_t(0x84 | (reg << 3)), 0x24});
+        emit32(disp);
+    }
+
+    /// The general purpose registers used by the stencils.
+    enum Reg : uint8_t
+    {
+        rax = 0,
+        rcx = 1,
+        rdx = 2,
+        rsi = 6,
+    };
+
+    /// <op> with the register and the memory operand [r12 + disp], e.g. mov rax, [r12 + disp]
+    /// or add [r12 + disp], rax depending on the opcode.
+    void mem(uint8_t opcode, Reg reg, int disp)
+    {
+        emit({0x49, opcode, uint8_t(0x44 | (reg << 3)), 0x24, uint8_t(int8_t(disp))});
+    }
+
+    /// The stack items in the stencils: the top and the second item.
+    static constexpr int top = 0;
+    static constexpr int second = -static_cast<int>(sizeof(uint256));
+
+    /// sub r12, 32: moves the stack top pointer down after the binary instruction.
+    void pop_item() { emit({0x49, 0x83, 0xec, 0x20}); }
+
+    /// Zeroes RCX and RDX for the boolean result: set<cc> cl and store_bool().
+    void clear_bool() { emit({0x31, 0xc9, 0x31, 0xd2}); }  // xor ecx, ecx; xor edx, edx
+
+    /// set<cc> cl
+    void setcc(uint8_t cc) { emit({0x0f, cc, 0xc1}); }
+
+    /// Stores the boolean result from RCX and the zero high words from RDX to the stack item.
+    void store_bool(int disp)
+    {
+        mem(0x89, rcx, disp);
+        for (int i = 1; i < 4; ++i)
+            mem(0x89, rdx, disp + 8 * i);
+    }
+
+    /// Calls the function with the Frame pointer as the argument. The result is in RAX.
+    void call_with_frame(const void* fn)
+    {
+        emit({0x48, 0x89, 0xdf});  // mov rdi, rbx
+        mov_rax(fn);
+        emit({0xff, 0xd0});  // call rax
+    }
+
+public:
+    /// Returns the size of the native code emitted so far.
+    [[nodiscard]] size_t size() const noexcept { return m_code.size(); }
+
+    /// Emits the entry of the native code: the function taking the Frame pointer.
+    void prologue()
+    {
+        emit({0x53});                    // push rbx
+        emit({0x41, 0x54});              // push r12
+        emit({0x48, 0x83, 0xec, 0x08});  // sub rsp, 8 (align the stack for the calls)
+        emit({0x48, 0x89, 0xfb});        // mov rbx, rdi
+        emit({0x4c, 0x8b, 0x63, 0x08});  // mov r12, [rbx + Frame::stack_top]
+    }
+
+    /// Emits the call of the instruction handler for the instruction at the code position.
+    /// The execution leaves the native code if the handler returns false.
+    void call_handler(Handler handler, const uint8_t* code_it)
+    {
+        mov_rax(code_it);
+        emit({0x48, 0x89, 0x03});        // mov [rbx + Frame::code_it], rax
+        emit({0x4c, 0x89, 0x63, 0x08});  // mov [rbx + Frame::stack_top], r12
+        call_with_frame(reinterpret_cast<const void*>(handler));
+        emit({0x84, 0xc0});  // test al, al
+        emit({0x0f, 0x84});  // jz epilogue
+        m_exit_jumps.push_back(m_code.size());
+        emit32(0);
+        emit({0x4c, 0x8b, 0x63, 0x08});  // mov r12, [rbx + Frame::stack_top]
+    }
+
+    /// Emits the jump to the native code address returned by the resolver.
+    void jump_resolved(Resolver resolver)
+    {
+        call_with_frame(reinterpret_cast<const void*>(resolver));
+        emit({0xff, 0xe0});  // jmp rax
+    }
+
+    /// Emits POP: moves the stack top pointer down.
+    void pop() { emit({0x49, 0x83, 0xec, 0x20}); }  // sub r12, 32
+
+    /// Emits PUSH of the constant value.
+    void push(const uint256& value)
+    {
+        for (size_t i = 0; i < 4; ++i)
+        {
+            mov_rax(value[i]);
+            emit({0x49, 0x89, 0x84, 0x24});  // mov [r12 + disp32], rax
+            emit32(static_cast<int32_t>(sizeof(uint256) + i * sizeof(uint64_t)));
+        }
+        emit({0x49, 0x83, 0xc4, 0x20});  // add r12, 32
+    }
+
+    /// Emits DUP<n>: copies the n-th stack item above the stack top.
+    void dup(int n)
+    {
+        const auto disp = -static_cast<int32_t>(sizeof(uint256)) * (n - 1);
+        movdqu(false, 0, disp);
+        movdqu(false, 1, disp + 16);
+        movdqu(true, 0, sizeof(uint256));
+        movdqu(true, 1, sizeof(uint256) + 16);
+        emit({0x49, 0x83, 0xc4, 0x20});  // add r12, 32
+    }
+
+    /// Emits SWAP<n>: exchanges the stack top item with the (n+1)-th one.
+    void swap(int n)
+    {
+        const auto disp = -static_cast<int32_t>(sizeof(uint256)) * n;
+        movdqu(false, 0, 0);
+        movdqu(false, 1, 16);
+        movdqu(false, 2, disp);
+        movdqu(false, 3, disp + 16);
+        movdqu(true, 2, 0);
+        movdqu(true, 3, 16);
+        movdqu(true, 0, disp);
+        movdqu(true, 1, disp + 16);
+    }
+
+    /// Emits ADD: stack[1] = stack[0] + stack[1].
+    void add()
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            mem(0x8b, rax, top + 8 * i);                     // mov rax, [top + 8i]
+            mem(i == 0 ? 0x01 : 0x11, rax, second + 8 * i);  // add/adc [second + 8i], rax
+        }
+        pop_item();
+    }
+
+    /// Emits SUB: stack[1] = stack[0] - stack[1].
+    void sub()
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            mem(0x8b, rax, top + 8 * i);                     // mov rax, [top + 8i]
+            mem(i == 0 ? 0x2b : 0x1b, rax, second + 8 * i);  // sub/sbb rax, [second + 8i]
+            mem(0x89, rax, second + 8 * i);                  // mov [second + 8i], rax
+        }
+        pop_item();
+    }
+
+    /// Emits AND, OR or XOR: stack[1] = stack[0] <op> stack[1].
+    /// @param opcode  The x86 opcode of <op> r/m64, r64.
+    void bitwise(uint8_t opcode)
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            mem(0x8b, rax, top + 8 * i);       // mov rax, [top + 8i]
+            mem(opcode, rax, second + 8 * i);  // <op> [second + 8i], rax
+        }
+        pop_item();
+    }
+
+    /// Emits AND.
+    void and_() { bitwise(0x21); }
+
+    /// Emits OR.
+    void or_() { bitwise(0x09); }
+
+    /// Emits XOR.
+    void xor_() { bitwise(0x31); }
+
+    /// Emits NOT: stack[0] = ~stack[0].
+    void not_()
+    {
+        for (int i = 0; i < 4; ++i)
+            emit({0x49, 0xf7, 0x54, 0x24, uint8_t(8 * i)});  // not qword [r12 + 8i]
+    }
+
+    /// Emits ISZERO: stack[0] = stack[0] == 0.
+    void iszero()
+    {
+        clear_bool();
+        mem(0x8b, rax, top);  // mov rax, [top]
+        for (int i = 1; i < 4; ++i)
+            mem(0x0b, rax, top + 8 * i);  // or rax, [top + 8i]
+        setcc(0x94);                      // sete cl
+        store_bool(top);
+    }
+
+    /// Emits EQ: stack[1] = stack[0] == stack[1].
+    void eq()
+    {
+        clear_bool();
+        mem(0x8b, rax, top);     // mov rax, [top]
+        mem(0x33, rax, second);  // xor rax, [second]
+        for (int i = 1; i < 4; ++i)
+        {
+            mem(0x8b, rsi, top + 8 * i);     // mov rsi, [top + 8i]
+            mem(0x33, rsi, second + 8 * i);  // xor rsi, [second + 8i]
+            emit({0x48, 0x09, 0xf0});        // or rax, rsi
+        }
+        setcc(0x94);  // sete cl
+        store_bool(second);
+        pop_item();
+    }
+
+    /// Emits the comparison stack[1] = a < b of the stack items a and b
+    /// by the subtraction a - b.
+    /// @param swapped  If false, a is the top item and b the second one (LT, SLT),
+    ///                 otherwise they are swapped (GT, SGT).
+    /// @param is_signed  Whether the signed comparison is used.
+    void compare(bool swapped, bool is_signed)
+    {
+        const auto a = swapped ? second : top;
+        const auto b = swapped ? top : second;
+        clear_bool();
+        for (int i = 0; i < 4; ++i)
+        {
+            mem(0x8b, rax, a + 8 * i);                  // mov rax, [a + 8i]
+            mem(i == 0 ? 0x2b : 0x1b, rax, b + 8 * i);  // sub/sbb rax, [b + 8i]
+        }
+        setcc(is_signed ? 0x9c : 0x92);  // setl cl or setb cl
+        store_bool(second);
+        pop_item();
+    }
+
+    /// Emits LT.
+    void lt() { compare(false, false); }
+
+    /// Emits GT.
+    void gt() { compare(true, false); }
+
+    /// Emits SLT.
+    void slt() { compare(false, true); }
+
+    /// Emits SGT.
+    void sgt() { compare(true, true); }
+
+    /// Emits the direct call of the stack-only instruction implementation
+    /// and moves the stack top pointer by its stack height change.
+    void call_stack_fn(StackFn fn, int stack_height_change)
+    {
+        emit({0x4c, 0x89, 0xe7});  // mov rdi, r12
+        mov_rax(reinterpret_cast<const void*>(fn));
+        emit({0xff, 0xd0});  // call rax
+        if (stack_height_change < 0)
+            emit({0x49, 0x83, 0xec, uint8_t(-stack_height_change * 32)});  // sub r12, imm8
+        else if (stack_height_change > 0)
+            emit({0x49, 0x83, 0xc4, uint8_t(stack_height_change * 32)});  // add r12, imm8
+    }
+
+    /// Emits the exit of the native code and returns the complete code.
+    std::vector<uint8_t> finish()
+    {
+        const auto epilogue = m_code.size();
+        emit({0x4c, 0x89, 0x63, 0x08});  // mov [rbx + Frame::stack_top], r12
+        emit({0x48, 0x83, 0xc4, 0x08});  // add rsp, 8
+        emit({0x41, 0x5c});              // pop r12
+        emit({0x5b});                    // pop rbx
+        emit({0xc3});                    // ret
+
+        for (const auto pos : m_exit_jumps)
+        {
+            const auto rel = static_cast<int32_t>(epilogue - (pos + sizeof(int32_t)));
+            std::memcpy(&m_code[pos], &rel, sizeof(rel));
+        }
+        return std::move(m_code);
+    }
+};
+
+/// The native code mapped into the executable memory.
+class ExecutableCode
+{
+    uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+
+    ExecutableCode(uint8_t* data, size_t size) noexcept : m_data{data}, m_size{size} {}
+
+public:
+    ExecutableCode() noexcept = default;
+    ExecutableCode(ExecutableCode&& other) noexcept
+      : m_data{std::exchange(other.m_data, nullptr)}, m_size{std::exchange(other.m_size, 0)}
+    {}
+    ExecutableCode& operator=(ExecutableCode&& other) noexcept
+    {
+        std::swap(m_data, other.m_data);
+        std::swap(m_size, other.m_size);
+        return *this;
+    }
+    ~ExecutableCode();
+
+    /// Copies the native code to the new executable memory mapping.
+    /// Returns the empty object if the mapping cannot be created.
+    static ExecutableCode map(const std::vector<uint8_t>& code) noexcept;
+
+    [[nodiscard]] const uint8_t* data() const noexcept { return m_data; }
+
+    [[nodiscard]] bool empty() const noexcept { return m_data == nullptr; }
+};
+
+/// The contract compiled by the JIT tier.
+struct CompiledCode
+{
+    /// The Baseline code analysis with the block requirements used by the instructions.
+    baseline::CodeAnalysis analysis;
+
+    ExecutableCode native;
+
+    /// The native code offsets of the instructions indexed by the code position.
+    std::vector<uint32_t> native_offsets;
+
+    /// Runs the native code from its entry.
+    void run(Frame& frame) const noexcept
+    {
+        using EntryFn = void (*)(Frame*) noexcept;
+        reinterpret_cast<EntryFn>(native.data())(&frame);
+    }
+};
+
+/// The JIT tier: counts the executions of contracts and compiles the ones executed
+/// the threshold number of times.
+///
+/// The contracts are identified by the ZVM revision and the code hash, and verified
+/// by the full code comparison. The number of tracked contracts is limited. The calls
+/// of other contracts are not counted.
+class Tier
+{
+    struct Entry
+    {
+        zvmc_revision rev;
+        bytes code;
+        uint64_t calls = 0;
+        std::shared_ptr<const CompiledCode> compiled;
+    };
+
+    const uint64_t m_threshold;
+    const size_t m_capacity;
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<uint64_t, Entry> m_entries;
+
+public:
+    /// The default maximum number of tracked contracts.
+    static constexpr size_t default_capacity = 4096;
+
+    /// Creates the tier compiling the contracts at the threshold-th call. The threshold must
+    /// not be 0.
+    explicit Tier(uint64_t threshold, size_t capacity = default_capacity) noexcept
+      : m_threshold{threshold}, m_capacity{capacity}
+    {}
+
+    Tier(const Tier&) = delete;
+    Tier& operator=(const Tier&) = delete;
+
+    /// Counts the call of the code and returns its compiled form or null if the code
+    /// is not compiled (yet).
+    ///
+    /// The compile function is invoked outside of the lock by the call reaching the threshold.
+    /// If it fails (returns null) the code is not compiled again.
+    template <typename CompileFn>
+    std::shared_ptr<const CompiledCode> get(
+        zvmc_revision rev, bytes_view code, CompileFn compile_fn) noexcept
+    {
+        const auto key = hash_code(code) ^ static_cast<uint64_t>(rev);
+        Entry* entry = nullptr;
+        {
+            const std::lock_guard lock{m_mutex};
+            auto it = m_entries.find(key);
+            if (it == m_entries.end())
+            {
+                if (m_entries.size() == m_capacity)
+                    return nullptr;
+                it = m_entries.emplace(key, Entry{rev, bytes{code}}).first;
+            }
+            else if (it->second.rev != rev || bytes_view{it->second.code} != code)
+                return nullptr;  // The hash collision: the slot stays with the first code.
+
+            entry = &it->second;  // Stable: the entries are never removed.
+            if (entry->compiled != nullptr || ++entry->calls != m_threshold)
+                return entry->compiled;
+        }
+
+        std::shared_ptr<const CompiledCode> compiled = compile_fn(rev, code);
+
+        const std::lock_guard lock{m_mutex};
+        entry->compiled = compiled;
+        return compiled;
+    }
+
+    /// Returns the number of the compiled contracts.
+    [[nodiscard]] size_t num_compiled() const noexcept
+    {
+        const std::lock_guard lock{m_mutex};
+        size_t n = 0;
+        for (const auto& [key, entry] : m_entries)
+            n += entry.compiled != nullptr;
+        return n;
+    }
+};
+}  // namespace zvmone::jit
@@ -0,0 +1,193 @@
+// zvmone: Fast Zond Virtual Machine implementation
+// Copyright 2026 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string_view>
+
+#include "instructions_opcodes.hpp"
+
+#if defined(__AVX2__) || defined(__SSE4_2__)
+#include <immintrin.h>
+#endif
+
+namespace zvmone::baseline
+{
+using bytes_view = std::basic_string_view<uint8_t>;
+
+// The JUMPDEST analysis functions build the bitmap of valid jump destinations.
+// The bit (i % 64) of the word (i / 64) is set if the code position i is a JUMPDEST instruction
+// (i.e. not a PUSH data byte). The bitmap must have at least (code.size() + 63) / 64 words
+// initialized with zeros.
+//
+// The analysis can also be done incrementally for the consecutive ranges of 64-byte chunks
+// (the bitmap words). The range analysis takes the number of PUSH data bytes continued from
+// the previous chunk and returns the one continued after the range.
+
+/// Analyzes the chunks [begin_chunk, end_chunk) of the code byte by byte.
+inline size_t analyze_jumpdests_bytewise(bytes_view code, uint64_t* bitmap, size_t begin_chunk,
+    size_t end_chunk, size_t carry) noexcept
+{
+    // To find if op is any PUSH opcode (OP_PUSH1 <= op <= OP_PUSH32)
+    // it can be noticed that OP_PUSH32 is INT8_MAX (0x7f) therefore
+    // static_cast<int8_t>(op) <= OP_PUSH32 is always true and can be skipped.
+    static_assert(OP_PUSH32 == std::numeric_limits<int8_t>::max());
+
+    const auto range_end = end_chunk * 64;
+    const auto end = std::min(range_end, code.size());
+    size_t i = begin_chunk * 64 + carry;
+    for (; i < end; ++i)
+    {
+        const auto op = code[i];
+        if (static_cast<int8_t>(op) >= OP_PUSH1)  // If any PUSH opcode (see explanation above).
+            i += op - size_t{OP_PUSH1 - 1};       // Skip PUSH data.
+        else if (op == OP_JUMPDEST)
+            bitmap[i / 64] |= uint64_t{1} << (i % 64);
+    }
+    return (i > range_end) ? i - range_end : 0;
+}
+
+/// Analyzes the code byte by byte.
+inline void analyze_jumpdests_bytewise(bytes_view code, uint64_t* bitmap) noexcept
+{
+    analyze_jumpdests_bytewise(code, bitmap, 0, (code.size() + 63) / 64, 0);
+}
+
+/// Whether the classification of 64-byte chunks uses SIMD instructions.
+/// This depends on the target x86-64 micro-architecture level (ZVMONE_X86_64_ARCH_LEVEL).
+#if defined(__AVX2__) || defined(__SSE4_2__)
+inline constexpr bool jumpdest_analysis_simd = true;
+#else
+inline constexpr bool jumpdest_analysis_simd = false;
+#endif
+
+/// The classification of a 64-byte code chunk: the bit i is set if the byte i is the opcode.
+struct ChunkMasks
+{
+    uint64_t jumpdest;  ///< The JUMPDEST bytes.
+    uint64_t push;      ///< The PUSH1-PUSH32 bytes.
+};
+
+/// Classifies 64 bytes of code.
+inline ChunkMasks classify_chunk(const uint8_t* chunk) noexcept
+{
+    // PUSH opcodes are the only ones greater than OP_PUSH1 - 1 when compared as signed bytes.
+    static_assert(OP_PUSH32 == std::numeric_limits<int8_t>::max());
+
+#if defined(__AVX2__)
+    const auto jumpdest = _mm256_set1_epi8(static_cast<char>(OP_JUMPDEST));
+    const auto push_min = _mm256_set1_epi8(static_cast<char>(OP_PUSH1 - 1));
+    const auto lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(chunk));
+    const auto hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(chunk + 32));
+    const auto mask = [](__m256i m) noexcept {
+        return uint64_t{static_cast<uint32_t>(_mm256_movemask_epi8(m))};
+    };
+    return {mask(_mm256_cmpeq_epi8(lo, jumpdest)) | (mask(_mm256_cmpeq_epi8(hi, jumpdest)) << 32),
+        mask(_mm256_cmpgt_epi8(lo, push_min)) | (mask(_mm256_cmpgt_epi8(hi, push_min)) << 32)};
+#elif defined(__SSE4_2__)
+    const auto jumpdest = _mm_set1_epi8(static_cast<char>(OP_JUMPDEST));
+    const auto push_min = _mm_set1_epi8(static_cast<char>(OP_PUSH1 - 1));
+    ChunkMasks masks{0, 0};
+    for (size_t i = 0; i < 64; i += 16)
+    {
+        const auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(chunk + i));
+        const auto j = static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, jumpdest)));
+        const auto p = static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(v, push_min)));
+        masks.jumpdest |= uint64_t{j} << i;
+        masks.push |= uint64_t{p} << i;
+    }
+    return masks;
+#else
+    ChunkMasks masks{0, 0};
+    for (size_t i = 0; i < 64; ++i)
+    {
+        masks.jumpdest |= uint64_t{chunk[i] == OP_JUMPDEST} << i;
+        masks.push |= uint64_t{static_cast<int8_t>(chunk[i]) >= OP_PUSH1} << i;
+    }
+    return masks;
+#endif
+}
+
+/// Analyzes the chunks [begin_chunk, end_chunk) of the code in 64-byte chunks.
+///
+/// The chunk is classified at once producing the masks of JUMPDEST and PUSH bytes.
+/// Then only the PUSH bytes are visited to compute the mask of PUSH data shadowing
+/// the JUMPDEST bytes. The PUSH data crossing the chunk boundary is carried to the next chunk.
+inline size_t analyze_jumpdests_chunked(bytes_view code, uint64_t* bitmap, size_t begin_chunk,
+    size_t end_chunk, size_t carry) noexcept
+{
+    const auto process_chunk = [&carry](const uint8_t* chunk, uint64_t& word) noexcept {
+        if (carry >= 64)
+        {
+            carry -= 64;  // The whole chunk is PUSH data.
+            return;
+        }
+
+        const auto masks = classify_chunk(chunk);
+        auto data = (uint64_t{1} << carry) - 1;
+        auto pushes = masks.push & ~data;
+        carry = 0;
+        while (pushes != 0)
+        {
+            const auto pos = static_cast<size_t>(std::countr_zero(pushes));
+            const auto data_begin = pos + 1;
+            const auto data_end = data_begin + (chunk[pos] - size_t{OP_PUSH1 - 1});
+            if (data_end >= 64)
+            {
+                if (data_begin < 64)
+                    data |= ~uint64_t{0} << data_begin;
+                carry = data_end - 64;
+                break;
+            }
+            data |= (uint64_t{1} << data_end) - (uint64_t{1} << data_begin);
+            pushes &= ~uint64_t{0} << data_end;
+        }
+        word = masks.jumpdest & ~data;
+    };
+
+    const auto num_full_chunks = code.size() / 64;
+    auto i = begin_chunk;
+    for (; i < std::min(end_chunk, num_full_chunks); ++i)
+        process_chunk(&code[i * 64], bitmap[i]);
+
+    if (const auto tail_size = code.size() % 64;
+        tail_size != 0 && i == num_full_chunks && i < end_chunk)
+    {
+        // The tail is padded with STOPs which are neither JUMPDEST nor PUSH.
+        uint8_t tail[64]{};
+        std::memcpy(tail, &code[num_full_chunks * 64], tail_size);
+        process_chunk(tail, bitmap[num_full_chunks]);
+    }
+    return carry;
+}
+
+/// Analyzes the code in 64-byte chunks.
+inline void analyze_jumpdests_chunked(bytes_view code, uint64_t* bitmap) noexcept
+{
+    analyze_jumpdests_chunked(code, bitmap, 0, (code.size() + 63) / 64, 0);
+}
+
+/// Analyzes the code with the fastest method available for the target.
+inline void analyze_jumpdests(bytes_view code, uint64_t* bitmap) noexcept
+{
+    if constexpr (jumpdest_analysis_simd)
+        analyze_jumpdests_chunked(code, bitmap);
+    else
+        analyze_jumpdests_bytewise(code, bitmap);
+}
+
+/// Analyzes the chunks [begin_chunk, end_chunk) with the fastest method available for the target.
+inline size_t analyze_jumpdests(bytes_view code, uint64_t* bitmap, size_t begin_chunk,
+    size_t end_chunk, size_t carry) noexcept
+{
+    if constexpr (jumpdest_analysis_simd)
+        return analyze_jumpdests_chunked(code, bitmap, begin_chunk, end_chunk, carry);
+    else
+        return analyze_jumpdests_bytewise(code, bitmap, begin_chunk, end_chunk, carry);
+}
+}  // namespace zvmone::baseline
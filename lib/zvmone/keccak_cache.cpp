@@ -0,0 +1,14 @@
+// zvmone: Fast Zond Virtual Machine implementation
+// Copyright 2026 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "keccak_cache.hpp"
+
+namespace zvmone
+{
+Keccak256Cache& Keccak256Cache::get_thread_local() noexcept
+{
+    thread_local Keccak256Cache cache;
+    return cache;
+}
+}  // namespace zvmone
@@ -0,0 +1,96 @@
+// zvmone: Fast Zond Virtual Machine implementation
+// Copyright 2026 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "analysis_cache.hpp"
+#include <ethash/keccak.hpp>
+#include <zvmc/zvmc.h>
+#include <cassert>
+#include <cstring>
+
+namespace zvmone
+{
+/// The counters of the Keccak256Cache.
+struct Keccak256CacheStats
+{
+    uint64_t hits = 0;    ///< The number of digests served from the cache.
+    uint64_t misses = 0;  ///< The number of digests computed with the Keccak permutation.
+};
+
+/// The cache of the KECCAK256 digests of the short inputs repeated within a transaction.
+///
+/// Solidity computes keccak256(key . slot) of the same 64 bytes for every access
+/// to a mapping element. The inputs of up to 64 bytes fit in a single Keccak block
+/// so every hit saves one Keccak permutation.
+///
+/// The cache is direct-mapped by the input hash and the entries are verified
+/// by comparing the full input. The entries are invalidated in constant time
+/// by advancing the generation number.
+///
+/// The cache is not thread-safe and is intended to be used as a thread_local object.
+class Keccak256Cache
+{
+public:
+    /// The maximum size of the cached inputs.
+    static constexpr size_t max_input_size = 64;
+
+    /// The number of cache entries.
+    static constexpr size_t num_entries = 256;
+
+private:
+    struct Entry
+    {
+        uint64_t generation = 0;        ///< The generation of the entry or 0 for the empty one.
+        uint64_t key = 0;               ///< The hash of the input.
+        size_t size = 0;                ///< The size of the input.
+        uint8_t input[max_input_size];  ///< The input.
+        ethash::hash256 digest;         ///< The Keccak256 digest of the input.
+    };
+
+    Entry m_entries[num_entries];
+
+    /// The generation of the valid entries.
+    uint64_t m_generation = 1;
+
+    Keccak256CacheStats m_stats;
+
+public:
+    Keccak256Cache() noexcept = default;
+    Keccak256Cache(const Keccak256Cache&) = delete;
+    Keccak256Cache& operator=(const Keccak256Cache&) = delete;
+
+    /// Returns the Keccak256 digest of the input from the cache or computes it.
+    /// The size must be in [1, max_input_size].
+    [[nodiscard]] ethash::hash256 keccak256(const uint8_t* data, size_t size) noexcept
+    {
+        assert(size != 0 && size <= max_input_size);
+
+        const auto key = hash_code({data, size});
+        auto& e = m_entries[key % num_entries];
+        if (e.generation == m_generation && e.key == key && e.size == size &&
+            std::memcmp(e.input, data, size) == 0)
+        {
+            ++m_stats.hits;
+            return e.digest;
+        }
+
+        ++m_stats.misses;
+        e.generation = m_generation;
+        e.key = key;
+        e.size = size;
+        std::memcpy(e.input, data, size);
+        e.digest = ethash::keccak256(data, size);
+        return e.digest;
+    }
+
+    /// Invalidates all entries. Called at the beginning of a transaction.
+    void clear() noexcept { ++m_generation; }
+
+    /// Returns the counters accumulated since the cache creation.
+    [[nodiscard]] const Keccak256CacheStats& stats() const noexcept { return m_stats; }
+
+    /// Returns the cache of the calling thread.
+    ZVMC_EXPORT static Keccak256Cache& get_thread_local() noexcept;
+};
+}  // namespace zvmone
@@ -0,0 +1,147 @@
+// zvmone: Fast Zond Virtual Machine implementation
+// Copyright 2026 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "analysis_cache.hpp"
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace zvmone
+{
+/// The thresholds of the contract promotion. The contract is promoted when any of them is reached.
+struct TieringThresholds
+{
+    /// The number of calls.
+    uint64_t calls = std::numeric_limits<uint64_t>::max();
+
+    /// The total gas used by the executions in the lower tier.
+    uint64_t gas = std::numeric_limits<uint64_t>::max();
+};
+
+/// The counters of the Tiering.
+struct TieringStats
+{
+    uint64_t tracked = 0;   ///< The number of tracked contracts.
+    uint64_t promoted = 0;  ///< The number of promoted contracts.
+};
+
+/// The tiering of the contract executions: tracks the calls and the executed gas
+/// of contracts and promotes the hot ones to the more expensively analyzed form.
+///
+/// The contracts are identified by the ZVM revision and the code hash, and verified
+/// by the full code comparison. The number of tracked contracts is limited; the calls
+/// of other contracts are not counted. The promoted analyses are kept for the lifetime
+/// of the object.
+template <typename AnalysisT>
+class Tiering
+{
+public:
+    /// The tracked contract.
+    struct Entry
+    {
+        zvmc_revision rev;
+        bytes code;
+        uint64_t calls = 0;
+        uint64_t gas_used = 0;
+        std::shared_ptr<const AnalysisT> promoted;
+    };
+
+    /// The result of the lookup of the contract about to be executed.
+    struct Lookup
+    {
+        /// The analysis of the promoted contract or null.
+        std::shared_ptr<const AnalysisT> promoted;
+
+        /// The entry of the tracked contract which is not promoted yet or null.
+        /// Used to report the gas used by the execution in the lower tier.
+        Entry* entry = nullptr;
+    };
+
+private:
+    const TieringThresholds m_thresholds;
+    const size_t m_capacity;
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<uint64_t, Entry> m_entries;
+    TieringStats m_stats;
+
+    [[nodiscard]] bool is_hot(const Entry& entry) const noexcept
+    {
+        return entry.calls >= m_thresholds.calls || entry.gas_used >= m_thresholds.gas;
+    }
+
+public:
+    /// The default maximum number of tracked contracts.
+    static constexpr size_t default_capacity = 4096;
+
+    explicit Tiering(TieringThresholds thresholds, size_t capacity = default_capacity) noexcept
+      : m_thresholds{thresholds}, m_capacity{capacity}
+    {}
+
+    Tiering(const Tiering&) = delete;
+    Tiering& operator=(const Tiering&) = delete;
+
+    /// Counts the call of the code and returns its promoted analysis if the contract is hot.
+    ///
+    /// The analysis function is invoked outside of the lock by the call promoting the contract.
+    template <typename AnalyzeFn>
+    Lookup get(zvmc_revision rev, bytes_view code, AnalyzeFn analyze_fn) noexcept
+    {
+        const auto key = hash_code(code) ^ static_cast<uint64_t>(rev);
+        Entry* entry = nullptr;
+        {
+            const std::lock_guard lock{m_mutex};
+            auto it = m_entries.find(key);
+            if (it == m_entries.end())
+            {
+                if (m_entries.size() == m_capacity)
+                    return {};
+                it = m_entries.emplace(key, Entry{rev, bytes{code}, 0, 0, nullptr}).first;
+                ++m_stats.tracked;
+            }
+            else if (it->second.rev != rev || bytes_view{it->second.code} != code)
+                return {};  // The hash collision: the slot stays with the first code.
+
+            entry = &it->second;  // Stable: the entries are never removed.
+            if (entry->promoted != nullptr)
+                return {entry->promoted, nullptr};
+
+            ++entry->calls;
+            if (!is_hot(*entry))
+                return {nullptr, entry};
+        }
+
+        // Concurrent calls may analyze the same hot code. The first stored analysis is kept.
+        auto analysis = std::make_shared<const AnalysisT>(analyze_fn(rev, code));
+
+        const std::lock_guard lock{m_mutex};
+        if (entry->promoted == nullptr)
+        {
+            entry->promoted = std::move(analysis);
+            ++m_stats.promoted;
+        }
+        return {entry->promoted, nullptr};
+    }
+
+    /// Adds the gas used by the execution of the contract in the lower tier.
+    void add_gas_used(Entry& entry, uint64_t gas_used) noexcept
+    {
+        const std::lock_guard lock{m_mutex};
+        entry.gas_used += gas_used;
+    }
+
+    /// Returns the thresholds of the promotion.
+    [[nodiscard]] const TieringThresholds& thresholds() const noexcept { return m_thresholds; }
+
+    /// Returns the snapshot of the counters.
+    [[nodiscard]] TieringStats stats() const noexcept
+    {
+        const std::lock_guard lock{m_mutex};
+        return m_stats;
+    }
+};
+}  // namespace zvmone
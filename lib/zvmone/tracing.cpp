@@ -6,6 +6,7 @@
 #include "execution_state.hpp"
 #include "instructions_traits.hpp"
 #include <zvmc/hex.hpp>
+#include <map>
 #include <stack>
 
 namespace zvmone
@@ -22,17 +23,44 @@ std::string get_name(uint8_t opcode)
 /// @see create_histogram_tracer()
 class HistogramTracer : public Tracer
 {
+    /// The maximum length of the counted instruction sequences.
+    static constexpr size_t max_sequence_length = 3;
+
     struct Context
     {
         const int32_t depth;
         const uint8_t* const code;
         uint32_t counts[256]{};
 
+        /// The counts of the executed sequences of instructions adjacent in the code.
+        std::map<std::basic_string<uint8_t>, uint32_t> sequence_counts;
+
+        /// The opcodes of the current sequence and the code position following it.
+        std::basic_string<uint8_t> sequence;
+        uint32_t sequence_end = 0;
+
         Context(int32_t _depth, const uint8_t* _code) noexcept : depth{_depth}, code{_code} {}
     };
 
     std::stack<Context> m_contexts;
     std::ostream& m_out;
+    const bool m_sequences;
+
+    /// Extends the current sequence with the instruction at pc and counts the sequences ending
+    /// at it. The sequence restarts when the instruction is not the next one in the code.
+    static void count_sequences(Context& ctx, uint32_t pc)
+    {
+        const auto opcode = ctx.code[pc];
+        if (pc != ctx.sequence_end)
+            ctx.sequence.clear();
+        else if (ctx.sequence.size() == max_sequence_length)
+            ctx.sequence.erase(0, 1);
+        ctx.sequence.push_back(opcode);
+        ctx.sequence_end = pc + 1 + instr::traits[opcode].immediate_size;
+
+        for (size_t len = 2; len <= ctx.sequence.size(); ++len)
+            ++ctx.sequence_counts[ctx.sequence.substr(ctx.sequence.size() - len)];
+    }
 
     void on_execution_start(
         zvmc_revision /*rev*/, const zvmc_message& msg, bytes_view code) noexcept override
@@ -45,6 +73,8 @@ class HistogramTracer : public Tracer
     {
         auto& ctx = m_contexts.top();
         ++ctx.counts[ctx.code[pc]];
+        if (m_sequences)
+            count_sequences(ctx, pc);
     }
 
     void on_execution_end(const zvmc_result& /*result*/) noexcept override
@@ -58,11 +88,24 @@ class HistogramTracer : public Tracer
                 m_out << get_name(static_cast<uint8_t>(i)) << ',' << ctx.counts[i] << '\n';
         }
 
+        if (m_sequences)
+        {
+            m_out << "--- # SEQUENCES depth=" << ctx.depth << "\nsequence,count\n";
+            for (const auto& [sequence, count] : ctx.sequence_counts)
+            {
+                for (size_t i = 0; i < sequence.size(); ++i)
+                    m_out << (i != 0 ? " " : "") << get_name(sequence[i]);
+                m_out << ',' << count << '\n';
+            }
+        }
+
         m_contexts.pop();
     }
 
 public:
-    explicit HistogramTracer(std::ostream& out) noexcept : m_out{out} {}
+    explicit HistogramTracer(std::ostream& out, bool sequences) noexcept
+      : m_out{out}, m_sequences{sequences}
+    {}
 };
 
 
@@ -151,9 +194,9 @@ public:
 };
 }  // namespace
 
-std::unique_ptr<Tracer> create_histogram_tracer(std::ostream& out)
+std::unique_ptr<Tracer> create_histogram_tracer(std::ostream& out, bool sequences)
 {
-    return std::make_unique<HistogramTracer>(out);
+    return std::make_unique<HistogramTracer>(out, sequences);
 }
 
 std::unique_ptr<Tracer> create_instruction_tracer(std::ostream& out)
@@ -59,9 +59,15 @@ private:
 /// Creates the "histogram" tracer which counts occurrences of individual opcodes during execution
 /// and reports this data in CSV format.
 ///
-/// @param out  Report output stream.
-/// @return     Histogram tracer object.
-ZVMC_EXPORT std::unique_ptr<Tracer> create_histogram_tracer(std::ostream& out);
+/// If sequences is true, the tracer also counts the executed sequences of 2 and 3 instructions
+/// adjacent in the code. This data drives the selection of the Baseline fused instructions
+/// (see test/internal_benchmarks/fused_opcodes.py).
+///
+/// @param out        Report output stream.
+/// @param sequences  Whether to count the instruction sequences.
+/// @return           Histogram tracer object.
+ZVMC_EXPORT std::unique_ptr<Tracer> create_histogram_tracer(
+    std::ostream& out, bool sequences = false);
 
 ZVMC_EXPORT std::unique_ptr<Tracer> create_instruction_tracer(std::ostream& out);
 
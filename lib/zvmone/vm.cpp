@@ -6,10 +6,12 @@
 /// ZVMC instance (class VM) and entry point of zvmone is defined here.
 
 #include "vm.hpp"
+#include "advanced_analysis.hpp"
 #include "advanced_execution.hpp"
 #include "baseline.hpp"
 #include <zvmone/zvmone.h>
 #include <cassert>
+#include <charconv>
 #include <iostream>
 
 namespace zvmone
@@ -27,6 +29,18 @@ constexpr zvmc_capabilities_flagset get_capabilities(zvmc_vm* /*vm*/) noexcept
     return ZVMC_CAPABILITY_ZVM1;
 }
 
+/// Sets the boolean option from the "yes" or "no" value.
+zvmc_set_option_result set_bool_option(bool& option, std::string_view value) noexcept
+{
+    if (value == "yes")
+        option = true;
+    else if (value == "no")
+        option = false;
+    else
+        return ZVMC_SET_OPTION_INVALID_VALUE;
+    return ZVMC_SET_OPTION_SUCCESS;
+}
+
 zvmc_set_option_result set_option(zvmc_vm* c_vm, char const* c_name, char const* c_value) noexcept
 {
     const auto name = (c_name != nullptr) ? std::string_view{c_name} : std::string_view{};
@@ -35,7 +49,9 @@ zvmc_set_option_result set_option(zvmc_vm* c_vm, char const* c_name, char const*
 
     if (name == "advanced")
     {
-        c_vm->execute = zvmone::advanced::execute;
+        // The "compact" value selects the compact instruction encoding.
+        c_vm->execute = (value == "compact") ? zvmone::advanced::execute_compact :
+                                               zvmone::advanced::execute;
         return ZVMC_SET_OPTION_SUCCESS;
     }
     else if (name == "cgoto")
@@ -51,6 +67,112 @@ zvmc_set_option_result set_option(zvmc_vm* c_vm, char const* c_name, char const*
         return ZVMC_SET_OPTION_INVALID_NAME;
 #endif
     }
+    else if (name == "tailcall")
+    {
+#if ZVMONE_TAILCALL_SUPPORTED
+        return set_bool_option(vm.tailcall, value);
+#else
+        return ZVMC_SET_OPTION_INVALID_NAME;
+#endif
+    }
+    else if (name == "block_checks")
+    {
+        return set_bool_option(vm.block_checks, value);
+    }
+    else if (name == "fusion")
+    {
+        return set_bool_option(vm.fusion, value);
+    }
+    else if (name == "lazy_jumpdests")
+    {
+        return set_bool_option(vm.lazy_jumpdests, value);
+    }
+    else if (name == "keccak_cache")
+    {
+        return set_bool_option(vm.keccak_cache, value);
+    }
+    else if (name == "analysis_cache")
+    {
+        // The value is the maximum number of cached analyses. The 0 disables the cache.
+        size_t capacity = 0;
+        const auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), capacity);
+        if (ec != std::errc{} || ptr != value.data() + value.size())
+            return ZVMC_SET_OPTION_INVALID_VALUE;
+
+        if (capacity != 0)
+            vm.analysis_cache = std::make_unique<AnalysisCache<baseline::CodeAnalysis>>(capacity);
+        else
+            vm.analysis_cache.reset();
+        return ZVMC_SET_OPTION_SUCCESS;
+    }
+    else if (name == "jit")
+    {
+#if ZVMONE_JIT_SUPPORTED
+        // The value is the number of calls after which the contract is compiled.
+        // The 0 disables the JIT tier.
+        uint64_t threshold = 0;
+        const auto [ptr, ec] =
+            std::from_chars(value.data(), value.data() + value.size(), threshold);
+        if (ec != std::errc{} || ptr != value.data() + value.size())
+            return ZVMC_SET_OPTION_INVALID_VALUE;
+
+        if (threshold != 0)
+            vm.jit_tier = std::make_unique<jit::Tier>(threshold);
+        else
+            vm.jit_tier.reset();
+        return ZVMC_SET_OPTION_SUCCESS;
+#else
+        return ZVMC_SET_OPTION_INVALID_NAME;
+#endif
+    }
+    else if (name == "aot")
+    {
+        // The value is the directory of the shared libraries with the compiled contracts.
+        // The empty value disables the compiled contracts.
+        if (value.empty())
+        {
+            vm.aot_registry.reset();
+            return ZVMC_SET_OPTION_SUCCESS;
+        }
+
+        auto registry = std::make_unique<aot::Registry>();
+        if (!registry->load_directory(std::string{value}))
+            return ZVMC_SET_OPTION_INVALID_VALUE;
+        vm.aot_registry = std::move(registry);
+        return ZVMC_SET_OPTION_SUCCESS;
+    }
+    else if (name == "tiering")
+    {
+        // The value is "CALLS" or "CALLS,GAS": the number of calls and the total gas used
+        // in Baseline after which the contract is promoted to Advanced. The 0 threshold is not
+        // used. The empty value or both thresholds unused disable the tiering.
+        const auto parse = [](std::string_view v, uint64_t& out) noexcept {
+            const auto [ptr, ec] = std::from_chars(v.data(), v.data() + v.size(), out);
+            return ec == std::errc{} && ptr == v.data() + v.size();
+        };
+
+        uint64_t calls = 0;
+        uint64_t gas = 0;
+        const auto comma = value.find(',');
+        if (!value.empty() && !parse(value.substr(0, comma), calls))
+            return ZVMC_SET_OPTION_INVALID_VALUE;
+        if (comma != std::string_view::npos && !parse(value.substr(comma + 1), gas))
+            return ZVMC_SET_OPTION_INVALID_VALUE;
+
+        if (calls == 0 && gas == 0)
+        {
+            vm.tiering.reset();
+            return ZVMC_SET_OPTION_SUCCESS;
+        }
+
+        TieringThresholds thresholds;
+        if (calls != 0)
+            thresholds.calls = calls;
+        if (gas != 0)
+            thresholds.gas = gas;
+        vm.tiering = std::make_unique<Tiering<advanced::AdvancedCodeAnalysis>>(thresholds);
+        return ZVMC_SET_OPTION_SUCCESS;
+    }
     else if (name == "trace")
     {
         vm.add_tracer(create_instruction_tracer(std::cerr));
@@ -58,7 +180,9 @@ zvmc_set_option_result set_option(zvmc_vm* c_vm, char const* c_name, char const*
     }
     else if (name == "histogram")
     {
-        vm.add_tracer(create_histogram_tracer(std::cerr));
+        // The "sequences" value also enables counting of the executed instruction sequences.
+        // Other values are ignored.
+        vm.add_tracer(create_histogram_tracer(std::cerr, value == "sequences"));
         return ZVMC_SET_OPTION_SUCCESS;
     }
     return ZVMC_SET_OPTION_INVALID_NAME;
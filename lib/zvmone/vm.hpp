@@ -3,6 +3,11 @@
 // SPDX-License-Identifier: Apache-2.0
 #pragma once
 
+#include "analysis_cache.hpp"
+#include "aot.hpp"
+#include "baseline.hpp"
+#include "jit.hpp"
+#include "tiering.hpp"
 #include "tracing.hpp"
 #include <zvmc/zvmc.h>
 
@@ -12,14 +17,60 @@
 #define ZVMONE_CGOTO_SUPPORTED 1
 #endif
 
+#if defined(__has_cpp_attribute)
+#if __has_cpp_attribute(clang::musttail)
+#define ZVMONE_TAILCALL_SUPPORTED 1
+#endif
+#endif
+#ifndef ZVMONE_TAILCALL_SUPPORTED
+#define ZVMONE_TAILCALL_SUPPORTED 0
+#endif
+
 namespace zvmone
 {
+namespace advanced
+{
+struct AdvancedCodeAnalysis;
+}
+
 /// The zvmone ZVMC instance.
 class VM : public zvmc_vm
 {
 public:
     bool cgoto = ZVMONE_CGOTO_SUPPORTED;
 
+    /// Use the tail-call threaded interpreter loop in Baseline (takes precedence over cgoto).
+    bool tailcall = false;
+
+    /// Check the stack and gas requirements once per basic block in Baseline.
+    bool block_checks = false;
+
+    /// Replace common instruction sequences with fused instructions in Baseline.
+    bool fusion = false;
+
+    /// Compute the valid jump destinations in Baseline lazily on the first jumps.
+    /// Not used with the analysis cache.
+    bool lazy_jumpdests = false;
+
+    /// Cache the KECCAK256 digests of the short inputs repeated within a transaction
+    /// in the thread's Keccak256Cache in Baseline.
+    bool keccak_cache = false;
+
+    /// The cache of Baseline code analyses shared by all executions. Disabled if null.
+    std::unique_ptr<AnalysisCache<baseline::CodeAnalysis>> analysis_cache;
+
+    /// The JIT tier compiling the frequently executed contracts to the native code.
+    /// Disabled if null. Not used when tracing.
+    std::unique_ptr<jit::Tier> jit_tier;
+
+    /// The ahead-of-time compiled contracts executed instead of Baseline. Disabled if null.
+    /// Not used when tracing.
+    std::unique_ptr<aot::Registry> aot_registry;
+
+    /// The tiering promoting the hot contracts from Baseline to the cached Advanced analysis.
+    /// Disabled if null. Not used when tracing nor for the ahead-of-time or JIT compiled code.
+    std::unique_ptr<Tiering<advanced::AdvancedCodeAnalysis>> tiering;
+
 private:
     std::unique_ptr<Tracer> m_first_tracer;
 
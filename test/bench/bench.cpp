@@ -104,14 +104,26 @@ std::vector<BenchmarkCase> load_benchmarks_from_dir(  // NOLINT(misc-no-recursio
 void register_benchmarks(std::span<const BenchmarkCase> benchmark_cases)
 {
     zvmc::VM* advanced_vm = nullptr;
+    zvmc::VM* acompact_vm = nullptr;
     zvmc::VM* baseline_vm = nullptr;
     zvmc::VM* basel_cg_vm = nullptr;
+    zvmc::VM* btailcall_vm = nullptr;
+    zvmc::VM* bblocks_vm = nullptr;
+    zvmc::VM* bfused_vm = nullptr;
     if (const auto it = registered_vms.find("advanced"); it != registered_vms.end())
         advanced_vm = &it->second;
+    if (const auto it = registered_vms.find("acompact"); it != registered_vms.end())
+        acompact_vm = &it->second;
     if (const auto it = registered_vms.find("baseline"); it != registered_vms.end())
         baseline_vm = &it->second;
     if (const auto it = registered_vms.find("bnocgoto"); it != registered_vms.end())
         basel_cg_vm = &it->second;
+    if (const auto it = registered_vms.find("btailcall"); it != registered_vms.end())
+        btailcall_vm = &it->second;
+    if (const auto it = registered_vms.find("bblocks"); it != registered_vms.end())
+        bblocks_vm = &it->second;
+    if (const auto it = registered_vms.find("bfused"); it != registered_vms.end())
+        bfused_vm = &it->second;
 
     for (const auto& b : benchmark_cases)
     {
@@ -123,6 +135,14 @@ void register_benchmarks(std::span<const BenchmarkCase> benchmark_cases)
             })->Unit(kMicrosecond);
         }
 
+        if (acompact_vm != nullptr)
+        {
+            RegisterBenchmark("acompact/analyse/" + b.name, [&b](State& state) {
+                bench_analyse<advanced::CompactCodeAnalysis, advanced_compact_analyse>(
+                    state, default_revision, b.code);
+            })->Unit(kMicrosecond);
+        }
+
         if (baseline_vm != nullptr)
         {
             RegisterBenchmark("baseline/analyse/" + b.name, [&b](State& state) {
@@ -131,6 +151,22 @@ void register_benchmarks(std::span<const BenchmarkCase> benchmark_cases)
             })->Unit(kMicrosecond);
         }
 
+        if (bblocks_vm != nullptr)
+        {
+            RegisterBenchmark("bblocks/analyse/" + b.name, [&b](State& state) {
+                bench_analyse<baseline::CodeAnalysis, baseline_blocks_analyse>(
+                    state, default_revision, b.code);
+            })->Unit(kMicrosecond);
+        }
+
+        if (bfused_vm != nullptr)
+        {
+            RegisterBenchmark("bfused/analyse/" + b.name, [&b](State& state) {
+                bench_analyse<baseline::CodeAnalysis, baseline_fused_analyse>(
+                    state, default_revision, b.code);
+            })->Unit(kMicrosecond);
+        }
+
         for (const auto& input : b.inputs)
         {
             const auto case_name = b.name + (!input.name.empty() ? '/' + input.name : "");
@@ -143,6 +179,15 @@ void register_benchmarks(std::span<const BenchmarkCase> benchmark_cases)
                 })->Unit(kMicrosecond);
             }
 
+            if (acompact_vm != nullptr)
+            {
+                const auto name = "acompact/execute/" + case_name;
+                RegisterBenchmark(name, [&vm = *acompact_vm, &b, &input](State& state) {
+                    bench_advanced_compact_execute(
+                        state, vm, b.code, input.input, input.expected_output);
+                })->Unit(kMicrosecond);
+            }
+
             if (baseline_vm != nullptr)
             {
                 const auto name = "baseline/execute/" + case_name;
@@ -159,6 +204,32 @@ void register_benchmarks(std::span<const BenchmarkCase> benchmark_cases)
                 })->Unit(kMicrosecond);
             }
 
+            if (btailcall_vm != nullptr)
+            {
+                const auto name = "btailcall/execute/" + case_name;
+                RegisterBenchmark(name, [&vm = *btailcall_vm, &b, &input](State& state) {
+                    bench_baseline_execute(state, vm, b.code, input.input, input.expected_output);
+                })->Unit(kMicrosecond);
+            }
+
+            if (bblocks_vm != nullptr)
+            {
+                const auto name = "bblocks/execute/" + case_name;
+                RegisterBenchmark(name, [&vm = *bblocks_vm, &b, &input](State& state) {
+                    bench_baseline_blocks_execute(
+                        state, vm, b.code, input.input, input.expected_output);
+                })->Unit(kMicrosecond);
+            }
+
+            if (bfused_vm != nullptr)
+            {
+                const auto name = "bfused/execute/" + case_name;
+                RegisterBenchmark(name, [&vm = *bfused_vm, &b, &input](State& state) {
+                    bench_baseline_fused_execute(
+                        state, vm, b.code, input.input, input.expected_output);
+                })->Unit(kMicrosecond);
+            }
+
             for (auto& [vm_name, vm] : registered_vms)
             {
                 const auto name = std::string{vm_name} + "/total/" + case_name;
@@ -272,8 +343,20 @@ int main(int argc, char** argv)
             return ec;
 
         registered_vms["advanced"] = zvmc::VM{zvmc_create_zvmone(), {{"advanced", ""}}};
+        registered_vms["acompact"] = zvmc::VM{zvmc_create_zvmone(), {{"advanced", "compact"}}};
         registered_vms["baseline"] = zvmc::VM{zvmc_create_zvmone()};
         registered_vms["bnocgoto"] = zvmc::VM{zvmc_create_zvmone(), {{"cgoto", "no"}}};
+#if ZVMONE_TAILCALL_SUPPORTED
+        registered_vms["btailcall"] = zvmc::VM{zvmc_create_zvmone(), {{"tailcall", "yes"}}};
+#endif
+        registered_vms["bblocks"] = zvmc::VM{zvmc_create_zvmone(), {{"block_checks", "yes"}}};
+        registered_vms["bfused"] = zvmc::VM{zvmc_create_zvmone(), {{"fusion", "yes"}}};
+        registered_vms["btiered"] = zvmc::VM{zvmc_create_zvmone(), {{"tiering", "2"}}};
+        registered_vms["blazy"] = zvmc::VM{zvmc_create_zvmone(), {{"lazy_jumpdests", "yes"}}};
+        registered_vms["bkeccak"] = zvmc::VM{zvmc_create_zvmone(), {{"keccak_cache", "yes"}}};
+#if ZVMONE_JIT_SUPPORTED
+        registered_vms["bjit"] = zvmc::VM{zvmc_create_zvmone(), {{"jit", "1"}}};
+#endif
         register_benchmarks(benchmark_cases);
         register_synthetic_benchmarks();
         RunSpecifiedBenchmarks();
@@ -39,11 +39,26 @@ inline advanced::AdvancedCodeAnalysis advanced_analyse(zvmc_revision rev, bytes_
     return advanced::analyze(rev, code);
 }
 
+inline advanced::CompactCodeAnalysis advanced_compact_analyse(zvmc_revision rev, bytes_view code)
+{
+    return advanced::analyze_compact(rev, code);
+}
+
 inline baseline::CodeAnalysis baseline_analyse(zvmc_revision rev, bytes_view code)
 {
     return baseline::analyze(rev, code);
 }
 
+inline baseline::CodeAnalysis baseline_blocks_analyse(zvmc_revision rev, bytes_view code)
+{
+    return baseline::analyze(rev, code, {.block_requirements = true});
+}
+
+inline baseline::CodeAnalysis baseline_fused_analyse(zvmc_revision rev, bytes_view code)
+{
+    return baseline::analyze(rev, code, {.fusion = true});
+}
+
 inline FakeCodeAnalysis zvmc_analyse(zvmc_revision /*rev*/, bytes_view /*code*/)
 {
     return {};
@@ -58,6 +73,14 @@ inline zvmc::Result advanced_execute(zvmc::VM& /*vm*/, advanced::AdvancedExecuti
     return zvmc::Result{execute(exec_state, analysis)};
 }
 
+inline zvmc::Result advanced_compact_execute(zvmc::VM& /*vm*/,
+    advanced::AdvancedExecutionState& exec_state, const advanced::CompactCodeAnalysis& analysis,
+    const zvmc_message& msg, zvmc_revision rev, zvmc::Host& host, bytes_view code)
+{
+    exec_state.reset(msg, rev, host.get_interface(), host.to_context(), code);
+    return zvmc::Result{execute(exec_state, analysis)};
+}
+
 inline zvmc::Result baseline_execute(zvmc::VM& c_vm, ExecutionState& exec_state,
     const baseline::CodeAnalysis& analysis, const zvmc_message& msg, zvmc_revision rev,
     zvmc::Host& host, bytes_view code)
@@ -148,9 +171,18 @@ inline void bench_execute(benchmark::State& state, zvmc::VM& vm, bytes_view code
 constexpr auto bench_advanced_execute = bench_execute<advanced::AdvancedExecutionState,
     advanced::AdvancedCodeAnalysis, advanced_execute, advanced_analyse>;
 
+constexpr auto bench_advanced_compact_execute = bench_execute<advanced::AdvancedExecutionState,
+    advanced::CompactCodeAnalysis, advanced_compact_execute, advanced_compact_analyse>;
+
 constexpr auto bench_baseline_execute =
     bench_execute<ExecutionState, baseline::CodeAnalysis, baseline_execute, baseline_analyse>;
 
+constexpr auto bench_baseline_blocks_execute = bench_execute<ExecutionState,
+    baseline::CodeAnalysis, baseline_execute, baseline_blocks_analyse>;
+
+constexpr auto bench_baseline_fused_execute = bench_execute<ExecutionState,
+    baseline::CodeAnalysis, baseline_execute, baseline_fused_analyse>;
+
 inline void bench_zvmc_execute(benchmark::State& state, zvmc::VM& vm, bytes_view code,
     bytes_view input = {}, bytes_view expected_output = {})
 {
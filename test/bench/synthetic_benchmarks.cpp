@@ -206,6 +206,47 @@ bytecode generate_loop_v2(const bytecode& inner_code)
            push(jumpdest_offset) + OP_JUMPI;     // jump to jumpdest_offset if counter != 0
 }
 
+/// The operands of the division, modular arithmetic and exponentiation benchmarks
+/// of a width class.
+struct ArithmeticOperands
+{
+    const char* width;   ///< The name of the width class.
+    std::string_view x;  ///< The dividend or the first operand in hex.
+    std::string_view y;  ///< The divisor or the second operand in hex.
+    std::string_view m;  ///< The modulus in hex.
+};
+
+constexpr ArithmeticOperands arithmetic_operands[]{
+    {"w64", "e1b4a7f3c2d5e6f7", "9a3c2b1d", "f2e3d4c5b6a79881"},
+    {"w128", "e1b4a7f3c2d5e6f7a8b9cadbecfd0e1f", "9a3c2b1d4e5f6a7b8c",
+        "f2e3d4c5b6a798810f1e2d3c4b5a6979"},
+    {"w256", "e1b4a7f3c2d5e6f7a8b9cadbecfd0e1f203142536475869708192a3b4c5d6e7f",
+        "9a3c2b1d4e5f6a7b8c9dae0f1021324354657687",
+        "f2e3d4c5b6a798810f1e2d3c4b5a69788796a5b4c3d2e1f00112233445566779"},
+};
+
+/// The EXP operands: the base (x) and the exponent (y).
+constexpr ArithmeticOperands exp_operands[]{
+    {"pow2", "02", "f8", {}},
+    {"pow256", "0100", "1f", {}},
+    {"small", "e1b4a7f3c2d5e6f7a8b9cadbecfd0e1f203142536475869708192a3b4c5d6e7f", "03", {}},
+    {"w64", "e1b4a7f3c2d5e6f7a8b9cadbecfd0e1f203142536475869708192a3b4c5d6e7f",
+        "9a3c2b1d4e5f6a7b", {}},
+    {"w256", "e1b4a7f3c2d5e6f7a8b9cadbecfd0e1f203142536475869708192a3b4c5d6e7f",
+        "9a3c2b1d4e5f6a7b8c9dae0f10213243546576879a3c2b1d4e5f6a7b8c9dae0f", {}},
+};
+
+/// Generates the ZVM benchmark loop inner code executing the division, modular arithmetic
+/// or exponentiation instruction with the given operands.
+bytecode generate_arithmetic_loop_inner_code(Opcode opcode, const ArithmeticOperands& operands)
+{
+    // PUSH(m) PUSH(y) PUSH(x) MULMOD POP ...
+    auto args = push(operands.y) + push(operands.x);
+    if (instr::traits[opcode].stack_height_required == 3)
+        args = push(operands.m) + args;
+    return 255 * (args + opcode + OP_POP);
+}
+
 bytes_view generate_code(CodeParams params)
 {
     static std::map<CodeParams, bytecode> cache;
@@ -262,6 +303,27 @@ void register_synthetic_benchmarks()
             [&vm_ = vm](State& state) { bench_zvmc_execute(state, vm_, generate_loop_v2({})); });
     }
 
+    const auto register_arithmetic_benchmark = [](Opcode opcode,
+                                                   const ArithmeticOperands& operands) {
+        const auto name = std::string{instr::traits[opcode].name} + '/' + operands.width;
+        const auto code = generate_loop_v2(generate_arithmetic_loop_inner_code(opcode, operands));
+        for (auto& [vm_name, vm] : registered_vms)
+        {
+            RegisterBenchmark(std::string{vm_name} + "/total/synth/" + name,
+                [&vm_ = vm, code](State& state) { bench_zvmc_execute(state, vm_, code); })
+                ->Unit(kMicrosecond);
+        }
+    };
+
+    for (const auto opcode : {OP_DIV, OP_MOD, OP_SDIV, OP_SMOD, OP_ADDMOD, OP_MULMOD})
+    {
+        for (const auto& operands : arithmetic_operands)
+            register_arithmetic_benchmark(opcode, operands);
+    }
+
+    for (const auto& operands : exp_operands)
+        register_arithmetic_benchmark(OP_EXP, operands);
+
     for (const auto params : params_list)
     {
         for (auto& [vm_name, vm] : registered_vms)
@@ -6,6 +6,7 @@
 #include <array>
 #include <random>
 #include <unordered_map>
+#include <vector>
 
 #pragma GCC diagnostic error "-Wconversion"
 
@@ -285,6 +286,78 @@ BENCHMARK_TEMPLATE(find_jumpdest_split_random, uint16_t, lower_bound);
 BENCHMARK_TEMPLATE(find_jumpdest_split_random, uint16_t, binary_search2);
 
 
+/// The dense map indexed by the jumpdest offset (as in AdvancedCodeAnalysis::jumpdest_map).
+template <typename T>
+struct dense_map_builder
+{
+    static const std::vector<T> map;
+};
+
+template <typename T>
+const std::vector<T> dense_map_builder<T>::map = []() noexcept {
+    auto m = std::vector<T>(2 * jumpdest_map_size + 1, T(-1));
+    for (size_t i = 0; i < jumpdest_map_size; ++i)
+        m[2 * i + 1] = static_cast<T>(2 * i + 2);
+    return m;
+}();
+
+template <typename T>
+inline T dense(const T* map, size_t size, T offset) noexcept
+{
+    const auto index = static_cast<size_t>(offset);
+    return index < size ? map[index] : T(-1);
+}
+
+template <typename T>
+void find_jumpdest_dense(benchmark::State& state)
+{
+    const auto& map = dense_map_builder<T>::map;
+    const auto begin = map.data();
+    const auto size = 2 * static_cast<size_t>(state.range(0)) + 1;  // Map for N jumpdests.
+    const auto needle = static_cast<T>(state.range(1));
+    benchmark::ClobberMemory();
+
+    T x = T(-1);
+    for (auto _ : state)
+    {
+        x = dense(begin, size, needle);
+        benchmark::DoNotOptimize(x);
+    }
+
+    if (needle % 2 == 1)
+    {
+        if (x != needle + 1)
+            state.SkipWithError("incorrect element found");
+    }
+    else if (x != T(-1))
+        state.SkipWithError("element should not have been found");
+}
+
+template <typename T>
+void find_jumpdest_dense_random(benchmark::State& state)
+{
+    const auto indexes = random_indexes;
+    const auto& map = dense_map_builder<T>::map;
+    const auto begin = map.data();
+    const auto size = map.size();
+    benchmark::ClobberMemory();
+
+    while (state.KeepRunningBatch(indexes.size()))
+    {
+        for (auto i : indexes)
+        {
+            auto x = dense(begin, size, static_cast<T>(i));
+            benchmark::DoNotOptimize(x);
+        }
+    }
+}
+
+BENCHMARK_TEMPLATE(find_jumpdest_dense, int) ARGS;
+BENCHMARK_TEMPLATE(find_jumpdest_dense, uint16_t) ARGS;
+BENCHMARK_TEMPLATE(find_jumpdest_dense_random, int);
+BENCHMARK_TEMPLATE(find_jumpdest_dense_random, uint16_t);
+
+
 template <typename T>
 void find_jumpdest_hashmap_random(benchmark::State& state)
 {
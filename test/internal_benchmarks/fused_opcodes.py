@@ -0,0 +1,92 @@
+#!/usr/bin/env python3
+
+# zvmone: Fast Zond Virtual Machine implementation
+# Copyright 2026 The evmone Authors.
+# SPDX-License-Identifier: Apache-2.0
+
+# Generates the ON_OPCODE_FUSED entries of MAP_OPCODES (lib/zvmone/instructions_xmacro.hpp)
+# from the instruction sequence histograms.
+#
+# The histograms are produced by the zvmone "histogram" option with the "sequences" value,
+# e.g. by running the benchmarks or state tests with
+#     --vm libzvmone.so,histogram=sequences 2> histogram.txt
+#
+# Usage: fused_opcodes.py [--slots N] histogram.txt...
+#
+# The sequences are ranked by the number of instruction dispatches saved: count * (length - 1).
+# The sequences which cannot be fused are skipped: the ones containing JUMPDEST or undefined
+# instructions, and the ones changing the control flow before the last instruction.
+
+import argparse
+import os
+import re
+import sys
+from collections import Counter
+
+ROOT = os.path.join(os.path.dirname(__file__), '..', '..')
+OPCODES_FILE = os.path.join(ROOT, 'lib', 'zvmone', 'instructions_opcodes.hpp')
+XMACRO_FILE = os.path.join(ROOT, 'lib', 'zvmone', 'instructions_xmacro.hpp')
+
+MAX_LENGTH = 4  # FusedInstruction::max_length in baseline.cpp.
+
+CONTROL_FLOW = {'STOP', 'JUMP', 'JUMPI', 'RETURN', 'REVERT', 'INVALID', 'SELFDESTRUCT'}
+
+
+def load_opcodes():
+    with open(OPCODES_FILE) as f:
+        return {m.group(1): int(m.group(2), 16)
+                for m in re.finditer(r'OP_(\w+) = (0x[0-9a-f]+)', f.read())}
+
+
+def load_free_slots():
+    """Returns the undefined opcodes, including the ones currently used for fused instructions."""
+    with open(XMACRO_FILE) as f:
+        text = f.read()
+    return sorted(int(m.group(1), 16)
+                  for m in re.finditer(r'ON_OPCODE_(?:UNDEFINED|FUSED)\((0x[0-9a-f]+)', text))
+
+
+def parse_histograms(paths):
+    sequences = Counter()
+    for path in paths:
+        in_sequences = False
+        with open(path) as f:
+            for line in f:
+                line = line.strip()
+                if line.startswith('--- #'):
+                    in_sequences = line.startswith('--- # SEQUENCES')
+                elif in_sequences and line != 'sequence,count':
+                    names, count = line.rsplit(',', 1)
+                    sequences[tuple(names.split())] += int(count)
+    return sequences
+
+
+def can_fuse(names, opcodes):
+    if len(names) > MAX_LENGTH:
+        return False
+    if any(name not in opcodes or name == 'JUMPDEST' for name in names):
+        return False
+    return not any(name in CONTROL_FLOW for name in names[:-1])
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Generates the fused opcodes.')
+    parser.add_argument('--slots', type=int, default=8, help='maximum number of fused opcodes')
+    parser.add_argument('histograms', nargs='+')
+    args = parser.parse_args()
+
+    opcodes = load_opcodes()
+    sequences = parse_histograms(args.histograms)
+    ranked = sorted(((count * (len(names) - 1), names) for names, count in sequences.items()
+                     if can_fuse(names, opcodes)), reverse=True)
+
+    slots = load_free_slots()
+    for slot, (saved, names) in zip(slots, ranked[:args.slots]):
+        entry = 'ON_OPCODE_FUSED({}, {})'.format(
+            '0x{:02x}'.format(slot), ', '.join('OP_' + name for name in names))
+        print('    {:<52}\\'.format(entry))
+        print('{}: saves {} dispatches'.format(entry, saved), file=sys.stderr)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,68 @@
+// zvmone: Fast Zond Virtual Machine implementation
+// Copyright 2026 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <benchmark/benchmark.h>
+#include <zvmone/jumpdest_analysis.hpp>
+#include <random>
+#include <vector>
+
+namespace
+{
+using zvmone::baseline::bytes_view;
+using analyze_fn = void (*)(bytes_view, uint64_t*) noexcept;
+
+/// The max code size (EIP-170).
+constexpr size_t code_size = 0x6000;
+
+/// Generates the code of the given kind:
+/// 0 - random bytes,
+/// 1 - PUSH-heavy code (every second instruction is a random PUSH),
+/// 2 - JUMPDEST-only code.
+std::basic_string<uint8_t> generate_code(int kind)
+{
+    std::basic_string<uint8_t> code(code_size, 0);
+    std::mt19937_64 rng{static_cast<uint64_t>(kind)};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+    for (size_t i = 0; i < code.size(); ++i)
+    {
+        const auto r = rng();
+        switch (kind)
+        {
+        case 0:
+            code[i] = static_cast<uint8_t>(r);
+            break;
+        case 1:
+            code[i] = static_cast<uint8_t>(
+                i % 2 == 0 ? zvmone::OP_PUSH1 + r % 32 : zvmone::OP_JUMPDEST);
+            break;
+        default:
+            code[i] = zvmone::OP_JUMPDEST;
+            break;
+        }
+    }
+    return code;
+}
+
+template <analyze_fn Fn>
+void jumpdest_analysis(benchmark::State& state)
+{
+    const auto code = generate_code(static_cast<int>(state.range(0)));
+    std::vector<uint64_t> bitmap((code.size() + 63) / 64);
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        std::fill(bitmap.begin(), bitmap.end(), uint64_t{0});
+        Fn(code, bitmap.data());
+        benchmark::DoNotOptimize(bitmap.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * code.size()));
+}
+
+#define ARGS ->DenseRange(0, 2)->ArgName("kind")
+
+BENCHMARK_TEMPLATE(jumpdest_analysis, zvmone::baseline::analyze_jumpdests_bytewise) ARGS;
+BENCHMARK_TEMPLATE(jumpdest_analysis, zvmone::baseline::analyze_jumpdests_chunked) ARGS;
+
+}  // namespace
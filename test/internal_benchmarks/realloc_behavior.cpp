@@ -4,9 +4,17 @@
 
 #include <chrono>
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <vector>
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#define HAVE_MMAP 1
+#else
+#define HAVE_MMAP 0
+#endif
+
 using namespace std::chrono;
 using timer = high_resolution_clock;
 
@@ -17,13 +25,56 @@ struct result
     decltype(timer::now() - timer::now()) duration;
 };
 
+constexpr int repeats = 6;
+constexpr size_t realloc_multiplier = 2;
+constexpr size_t size_start = 128 * 1024;
+constexpr size_t size_end = 8 * 1024 * 1024;
+
+/// Writes a byte to every page of the memory extension to include the cost of page faults.
+void touch_pages(void* m, size_t begin, size_t end)
+{
+    constexpr size_t page_size = 4096;
+    for (auto i = begin; i < end; i += page_size)
+        static_cast<volatile char*>(m)[i] = 1;
+}
+
+void print_results(const char* title, const std::vector<result>& results)
+{
+    std::cout << title << "\n";
+    for (auto r : results)
+    {
+        std::cout << (r.size / 1024) << "k\t " << r.memory_ptr << "\t"
+                  << duration_cast<nanoseconds>(r.duration).count() << "\n";
+    }
+}
+
 void benchmark_realloc()
 {
-    constexpr int repeats = 6;
-    constexpr size_t realloc_multiplier = 2;
-    constexpr size_t size_start = 128 * 1024;
-    constexpr size_t size_end = 8 * 1024 * 1024;
+    auto results = std::vector<result>{};
+    results.reserve(size_end / size_start);
+
+    void* m = nullptr;
+
+    for (int i = 0; i < repeats; ++i)
+    {
+        for (auto size = size_start; size <= size_end; size *= realloc_multiplier)
+        {
+            const auto start_time = timer::now();
+            m = std::realloc(m, size);
+            const auto duration = timer::now() - start_time;
+            results.push_back({size, m, duration});
+        }
+        std::free(m);
+        m = nullptr;
+    }
+
+    print_results("realloc", results);
+}
 
+/// The growth of the ZVM memory with the heap allocation: the capacity is reallocated
+/// and the extension is zeroed.
+void benchmark_realloc_memset()
+{
     auto results = std::vector<result>{};
     results.reserve(size_end / size_start);
 
@@ -31,26 +82,72 @@ void benchmark_realloc()
 
     for (int i = 0; i < repeats; ++i)
     {
+        size_t old_size = 0;
         for (auto size = size_start; size <= size_end; size *= realloc_multiplier)
         {
             const auto start_time = timer::now();
             m = std::realloc(m, size);
+            std::memset(static_cast<char*>(m) + old_size, 0, size - old_size);
+            touch_pages(m, old_size, size);
             const auto duration = timer::now() - start_time;
             results.push_back({size, m, duration});
+            old_size = size;
         }
         std::free(m);
         m = nullptr;
     }
 
-    for (auto r : results)
+    print_results("realloc + memset", results);
+}
+
+/// The growth of the ZVM memory with the anonymous mapping (ZVMONE_MEMORY_MMAP): the new pages
+/// are zero so the extension is not cleared, and on Linux the pages are moved without copying.
+void benchmark_mmap()
+{
+#if HAVE_MMAP
+    auto results = std::vector<result>{};
+    results.reserve(size_end / size_start);
+
+    for (int i = 0; i < repeats; ++i)
     {
-        std::cout << (r.size / 1024) << "k\t " << r.memory_ptr << "\t"
-                  << duration_cast<nanoseconds>(r.duration).count() << "\n";
+        void* m = nullptr;
+        size_t old_size = 0;
+        for (auto size = size_start; size <= size_end; size *= realloc_multiplier)
+        {
+            const auto start_time = timer::now();
+#if defined(__linux__)
+            if (m != nullptr)
+                m = mremap(m, old_size, size, MREMAP_MAYMOVE);
+            else
+#endif
+            {
+                auto* const p = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+                if (m != nullptr)
+                {
+                    std::memcpy(p, m, old_size);
+                    munmap(m, old_size);
+                }
+                m = p;
+            }
+            if (m == MAP_FAILED)
+                std::abort();
+            touch_pages(m, old_size, size);
+            const auto duration = timer::now() - start_time;
+            results.push_back({size, m, duration});
+            old_size = size;
+        }
+        munmap(m, old_size);
     }
+
+    print_results("mmap", results);
+#endif
 }
 
 int main()
 {
     benchmark_realloc();
+    benchmark_realloc_memset();
+    benchmark_mmap();
     return 0;
 }
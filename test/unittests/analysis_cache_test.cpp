@@ -0,0 +1,255 @@
+// zvmone: Fast Zond Virtual Machine implementation
+// Copyright 2026 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+#include <test/utils/bytecode.hpp>
+#include <zvmc/mocked_host.hpp>
+#include <zvmone/analysis_cache.hpp>
+#include <zvmone/baseline.hpp>
+#include <zvmone/vm.hpp>
+#include <zvmone/zvmone.h>
+
+using namespace zvmone;
+
+namespace
+{
+/// The fake analysis counting how many times the code has been analyzed.
+struct CountingAnalysis
+{
+    size_t code_size = 0;
+};
+
+int num_analyses = 0;
+
+CountingAnalysis counting_analyze(zvmc_revision /*rev*/, bytes_view code)
+{
+    ++num_analyses;
+    return {code.size()};
+}
+
+/// The tracer counting the executed instructions.
+class StepCounter final : public Tracer
+{
+    size_t& m_num_steps;
+
+    void on_execution_start(
+        zvmc_revision /*rev*/, const zvmc_message& /*msg*/, bytes_view /*code*/) noexcept override
+    {}
+
+    void on_instruction_start(uint32_t /*pc*/, const intx::uint256* /*stack_top*/,
+        int /*stack_height*/, int64_t /*gas*/, const ExecutionState& /*state*/) noexcept override
+    {
+        ++m_num_steps;
+    }
+
+    void on_execution_end(const zvmc_result& /*result*/) noexcept override {}
+
+public:
+    explicit StepCounter(size_t& num_steps) noexcept : m_num_steps{num_steps} {}
+};
+}  // namespace
+
+TEST(analysis_cache, hash_code)
+{
+    const auto a = bytecode{"6001600201"};
+    const auto b = bytecode{"6001600202"};
+    EXPECT_EQ(hash_code(a), hash_code(a));
+    EXPECT_NE(hash_code(a), hash_code(b));
+    EXPECT_NE(hash_code({}), hash_code(bytecode{OP_STOP}));
+    EXPECT_NE(hash_code(bytecode{OP_STOP}), hash_code(2 * OP_STOP));
+}
+
+TEST(analysis_cache, hit_and_miss)
+{
+    num_analyses = 0;
+    AnalysisCache<CountingAnalysis> cache{4};
+    const auto code = push(1) + push(2) + OP_ADD;
+
+    const auto a1 = cache.get(ZVMC_SHANGHAI, code, counting_analyze);
+    const auto a2 = cache.get(ZVMC_SHANGHAI, code, counting_analyze);
+    EXPECT_EQ(a1, a2);
+    EXPECT_EQ(a1->code_size, code.size());
+    EXPECT_EQ(num_analyses, 1);
+    EXPECT_EQ(cache.size(), 1);
+
+    const auto stats = cache.stats();
+    EXPECT_EQ(stats.hits, 1);
+    EXPECT_EQ(stats.misses, 1);
+    EXPECT_EQ(stats.evictions, 0);
+}
+
+TEST(analysis_cache, same_code_different_buffer)
+{
+    num_analyses = 0;
+    AnalysisCache<CountingAnalysis> cache{4};
+    const auto code1 = push(1) + OP_POP;
+    const auto code2 = bytecode{code1};  // The same code in another buffer.
+
+    cache.get(ZVMC_SHANGHAI, code1, counting_analyze);
+    cache.get(ZVMC_SHANGHAI, code2, counting_analyze);
+    EXPECT_EQ(num_analyses, 1);
+    EXPECT_EQ(cache.stats().hits, 1);
+}
+
+TEST(analysis_cache, variants)
+{
+    num_analyses = 0;
+    AnalysisCache<CountingAnalysis> cache{4};
+    const auto code = push(1) + OP_POP;
+
+    const auto a0 = cache.get(ZVMC_SHANGHAI, code, counting_analyze, 0);
+    const auto a1 = cache.get(ZVMC_SHANGHAI, code, counting_analyze, 1);
+    EXPECT_NE(a0, a1);
+    EXPECT_EQ(cache.get(ZVMC_SHANGHAI, code, counting_analyze, 0), a0);
+    EXPECT_EQ(cache.get(ZVMC_SHANGHAI, code, counting_analyze, 1), a1);
+    EXPECT_EQ(num_analyses, 2);
+    EXPECT_EQ(cache.size(), 2);
+}
+
+TEST(analysis_cache, eviction)
+{
+    num_analyses = 0;
+    AnalysisCache<CountingAnalysis> cache{2};
+    const auto code1 = bytecode{push(1)};
+    const auto code2 = bytecode{push(2)};
+    const auto code3 = bytecode{push(3)};
+
+    const auto a1 = cache.get(ZVMC_SHANGHAI, code1, counting_analyze);
+    cache.get(ZVMC_SHANGHAI, code2, counting_analyze);
+    cache.get(ZVMC_SHANGHAI, code1, counting_analyze);  // code1 is now the most recently used.
+    cache.get(ZVMC_SHANGHAI, code3, counting_analyze);  // Evicts code2.
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_EQ(num_analyses, 3);
+
+    cache.get(ZVMC_SHANGHAI, code1, counting_analyze);
+    EXPECT_EQ(num_analyses, 3);
+    cache.get(ZVMC_SHANGHAI, code2, counting_analyze);  // Evicts code3.
+    EXPECT_EQ(num_analyses, 4);
+
+    const auto stats = cache.stats();
+    EXPECT_EQ(stats.hits, 2);
+    EXPECT_EQ(stats.misses, 4);
+    EXPECT_EQ(stats.evictions, 2);
+
+    // The analysis obtained before the eviction is still valid.
+    EXPECT_EQ(a1->code_size, code1.size());
+}
+
+TEST(analysis_cache, shards)
+{
+    num_analyses = 0;
+    AnalysisCache<CountingAnalysis> cache{1024};
+    EXPECT_EQ(cache.num_shards(), 16);
+    EXPECT_EQ(AnalysisCache<CountingAnalysis>{100}.num_shards(), 1);
+
+    for (uint64_t i = 0; i < 2048; ++i)
+        cache.get(ZVMC_SHANGHAI, push(i), counting_analyze);
+    for (uint64_t i = 2048 - 32; i < 2048; ++i)
+        cache.get(ZVMC_SHANGHAI, push(i), counting_analyze);
+    EXPECT_LE(cache.size(), 1024);
+    EXPECT_EQ(num_analyses, 2048);
+
+    const auto stats = cache.stats();
+    EXPECT_EQ(stats.hits, 32);
+    EXPECT_EQ(stats.misses, 2048);
+    EXPECT_EQ(stats.evictions, 2048 - cache.size());
+}
+
+TEST(analysis_cache, baseline_analysis)
+{
+    // The baseline analysis keeps the code unless fused: the hits are verified against it.
+    AnalysisCache<baseline::CodeAnalysis> cache{4};
+    const auto code1 = add(push(1), push(2));
+    const auto code2 = bytecode{code1};  // The same code in another buffer.
+    const auto code3 = add(push(1), push(3));
+
+    for (const bool fusion : {false, true})
+    {
+        const auto analyze = [fusion](zvmc_revision rev, bytes_view code) {
+            return baseline::analyze(rev, code, {.fusion = fusion});
+        };
+        const auto variant = uint32_t{fusion};
+        const auto a1 = cache.get(ZVMC_SHANGHAI, code1, analyze, variant);
+        EXPECT_EQ(a1->is_fused(), fusion);
+        EXPECT_EQ(cache.get(ZVMC_SHANGHAI, code2, analyze, variant), a1);
+        EXPECT_NE(cache.get(ZVMC_SHANGHAI, code3, analyze, variant), a1);
+    }
+    const auto stats = cache.stats();
+    EXPECT_EQ(stats.hits, 2);
+    EXPECT_EQ(stats.misses, 4);
+}
+
+TEST(analysis_cache, vm_option)
+{
+    auto vm = zvmc::VM{zvmc_create_zvmone()};
+    auto& zvmone_vm = *static_cast<zvmone::VM*>(vm.get_raw_pointer());
+    EXPECT_FALSE(zvmone_vm.analysis_cache);
+
+    EXPECT_EQ(vm.set_option("analysis_cache", ""), ZVMC_SET_OPTION_INVALID_VALUE);
+    EXPECT_EQ(vm.set_option("analysis_cache", "-1"), ZVMC_SET_OPTION_INVALID_VALUE);
+    EXPECT_EQ(vm.set_option("analysis_cache", "10x"), ZVMC_SET_OPTION_INVALID_VALUE);
+
+    ASSERT_EQ(vm.set_option("analysis_cache", "16"), ZVMC_SET_OPTION_SUCCESS);
+    ASSERT_TRUE(zvmone_vm.analysis_cache);
+    EXPECT_EQ(zvmone_vm.analysis_cache->capacity(), 16);
+
+    zvmc::MockedHost host;
+    zvmc_message msg{};
+    msg.gas = 100;
+    const auto code = ret(add(push(1), push(2)));
+    for (int i = 0; i < 3; ++i)
+    {
+        const auto r = vm.execute(host, ZVMC_SHANGHAI, msg, code.data(), code.size());
+        ASSERT_EQ(r.status_code, ZVMC_SUCCESS);
+        ASSERT_EQ(r.output_size, 32);
+        EXPECT_EQ(r.output_data[31], 3);
+    }
+
+    const auto stats = zvmone_vm.analysis_cache->stats();
+    EXPECT_EQ(stats.hits, 2);
+    EXPECT_EQ(stats.misses, 1);
+    EXPECT_EQ(stats.evictions, 0);
+
+    EXPECT_EQ(vm.set_option("analysis_cache", "0"), ZVMC_SET_OPTION_SUCCESS);
+    EXPECT_FALSE(zvmone_vm.analysis_cache);
+}
+
+TEST(analysis_cache, vm_analysis_options)
+{
+    zvmc::MockedHost host;
+    zvmc_message msg{};
+    msg.gas = 100;
+    const auto code = ret(add(push(1), push(2)));  // PUSH1 and ADD are fused.
+
+    size_t expected_steps = 0;
+    {
+        auto vm = zvmc::VM{zvmc_create_zvmone()};
+        static_cast<zvmone::VM*>(vm.get_raw_pointer())
+            ->add_tracer(std::make_unique<StepCounter>(expected_steps));
+        ASSERT_EQ(vm.execute(host, ZVMC_SHANGHAI, msg, code.data(), code.size()).status_code,
+            ZVMC_SUCCESS);
+    }
+
+    auto vm = zvmc::VM{zvmc_create_zvmone()};
+    auto& zvmone_vm = *static_cast<zvmone::VM*>(vm.get_raw_pointer());
+    ASSERT_EQ(vm.set_option("analysis_cache", "16"), ZVMC_SET_OPTION_SUCCESS);
+    ASSERT_EQ(vm.set_option("fusion", "yes"), ZVMC_SET_OPTION_SUCCESS);
+    ASSERT_EQ(vm.execute(host, ZVMC_SHANGHAI, msg, code.data(), code.size()).status_code,
+        ZVMC_SUCCESS);
+
+    // The fused analysis cached before is not used for tracing: all instructions are traced.
+    size_t num_steps = 0;
+    zvmone_vm.add_tracer(std::make_unique<StepCounter>(num_steps));
+    ASSERT_EQ(vm.execute(host, ZVMC_SHANGHAI, msg, code.data(), code.size()).status_code,
+        ZVMC_SUCCESS);
+    EXPECT_EQ(num_steps, expected_steps);
+    EXPECT_EQ(zvmone_vm.analysis_cache->stats().misses, 2);
+
+    // The block checks need another analysis too.
+    ASSERT_EQ(vm.set_option("block_checks", "yes"), ZVMC_SET_OPTION_SUCCESS);
+    ASSERT_EQ(vm.execute(host, ZVMC_SHANGHAI, msg, code.data(), code.size()).status_code,
+        ZVMC_SUCCESS);
+    EXPECT_EQ(zvmone_vm.analysis_cache->stats().misses, 3);
+    EXPECT_EQ(zvmone_vm.analysis_cache->size(), 3);
+}
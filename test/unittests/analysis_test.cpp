@@ -60,6 +60,8 @@ TEST(analysis, push)
 
     ASSERT_EQ(analysis.instrs.size(), 4);
     ASSERT_EQ(analysis.push_values.size(), 1);
+    EXPECT_GE(analysis.instrs.capacity(), analysis.instrs.size());
+    EXPECT_GE(analysis.push_values.capacity(), analysis.push_values.size());
     EXPECT_EQ(analysis.instrs[0].fn, op_tbl[OPX_BEGINBLOCK].fn);
     EXPECT_EQ(analysis.instrs[1].arg.small_push_value, push_value);
     EXPECT_EQ(analysis.instrs[2].arg.push_value, analysis.push_values.data());
@@ -93,6 +95,24 @@ TEST(analysis, jump1)
     EXPECT_EQ(find_jumpdest(analysis, 6), 5);
     EXPECT_EQ(find_jumpdest(analysis, 0), -1);
     EXPECT_EQ(find_jumpdest(analysis, 7), -1);
+    EXPECT_EQ(find_jumpdest(analysis, static_cast<int>(code.size())), -1);
+
+    ASSERT_EQ(analysis.jumpdest_map.size(), code.size());
+    EXPECT_EQ(analysis.jumpdest_map[6], 5);
+    EXPECT_EQ(analysis.jumpdest_map[0], -1);
+}
+
+TEST(analysis, jumpdest_map_large_code)
+{
+    // For large code the dense jumpdest map is not built and the offsets are searched.
+    const auto code = static_cast<int>(max_dense_jumpdest_map_code_size + 1) * OP_JUMPDEST;
+    const auto analysis = analyze(rev, code);
+
+    EXPECT_TRUE(analysis.jumpdest_map.empty());
+    ASSERT_EQ(analysis.jumpdest_offsets.size(), code.size());
+    EXPECT_EQ(find_jumpdest(analysis, 0), 1);
+    EXPECT_EQ(find_jumpdest(analysis, 0x6000), 0x6001);
+    EXPECT_EQ(find_jumpdest(analysis, 0x6001), -1);
 }
 
 TEST(analysis, empty)
@@ -150,7 +170,8 @@ TEST(analysis, jump_dead_code)
     ASSERT_EQ(analysis.instrs.size(), 5);
     EXPECT_EQ(analysis.instrs[0].arg.block.gas_cost, 3 + 8);
     EXPECT_EQ(analysis.instrs[0].fn, op_tbl[OPX_BEGINBLOCK].fn);
-    EXPECT_EQ(analysis.instrs[1].fn, op_tbl[OP_PUSH1].fn);
+    EXPECT_EQ(analysis.instrs[1].fn, get_static_jump_fn(false));
+    EXPECT_EQ(analysis.instrs[1].arg.number, jumpdest_index);
     EXPECT_EQ(analysis.instrs[2].fn, op_tbl[OP_JUMP].fn);
 
     EXPECT_EQ(analysis.instrs[jumpdest_index].arg.block.gas_cost, 1);
@@ -210,7 +231,8 @@ TEST(analysis, jumpi_jumpdest)
     ASSERT_EQ(analysis.instrs.size(), 5);
     EXPECT_EQ(analysis.instrs[0].arg.block.gas_cost, 3 + 10);
     EXPECT_EQ(analysis.instrs[0].fn, op_tbl[OPX_BEGINBLOCK].fn);
-    EXPECT_EQ(analysis.instrs[1].fn, op_tbl[OP_PUSH1].fn);
+    EXPECT_EQ(analysis.instrs[1].fn, get_static_jump_fn(true));
+    EXPECT_EQ(analysis.instrs[1].arg.number, -1);  // The destination 0 is not a JUMPDEST.
     EXPECT_EQ(analysis.instrs[2].fn, op_tbl[OP_JUMPI].fn);
     EXPECT_EQ(analysis.instrs[2].arg.block.gas_cost, 0);  // The block following JUMPI is empty.
 
@@ -233,7 +255,8 @@ TEST(analysis, jumpdests_groups)
     EXPECT_EQ(analysis.instrs[5].fn, op_tbl[OP_JUMPDEST].fn);
     EXPECT_EQ(analysis.instrs[6].fn, op_tbl[OP_JUMPDEST].fn);
     EXPECT_EQ(analysis.instrs[7].fn, op_tbl[OP_JUMPDEST].fn);
-    EXPECT_EQ(analysis.instrs[8].fn, op_tbl[OP_PUSH1].fn);
+    EXPECT_EQ(analysis.instrs[8].fn, get_static_jump_fn(true));
+    EXPECT_EQ(analysis.instrs[8].arg.number, 3);
     EXPECT_EQ(analysis.instrs[9].fn, op_tbl[OP_JUMPI].fn);
     EXPECT_EQ(analysis.instrs[10].fn, op_tbl[OP_STOP].fn);
 
@@ -253,3 +276,119 @@ TEST(analysis, jumpdests_groups)
     EXPECT_EQ(analysis.jumpdest_offsets[5], 7);
     EXPECT_EQ(analysis.jumpdest_targets[5], 7);
 }
+
+TEST(analysis, static_jump_large_push)
+{
+    // Only the destinations pushed by PUSH1-PUSH8 are resolved statically.
+    const auto code =
+        push("000000000000000000") + OP_JUMP + OP_JUMPDEST + push(0xffffffffff) + OP_JUMP;
+    const auto analysis = analyze(rev, code);
+
+    ASSERT_EQ(analysis.instrs.size(), 7);
+    EXPECT_EQ(analysis.instrs[1].fn, op_tbl[OP_PUSH9].fn);
+    EXPECT_EQ(analysis.instrs[2].fn, op_tbl[OP_JUMP].fn);
+    EXPECT_EQ(analysis.instrs[3].fn, op_tbl[OP_JUMPDEST].fn);
+    EXPECT_EQ(analysis.instrs[4].fn, get_static_jump_fn(false));
+    EXPECT_EQ(analysis.instrs[4].arg.number, -1);  // The destination exceeds the int range.
+    EXPECT_EQ(analysis.instrs[5].fn, op_tbl[OP_JUMP].fn);
+}
+
+TEST(analysis, compact_example1)
+{
+    const auto code = push(0x2a) + push(0x1e) + OP_MSTORE8 + OP_MSIZE + push(0) + OP_SSTORE;
+    const auto analysis = analyze_compact(rev, code);
+
+    ASSERT_EQ(analysis.instrs.size(), 8);
+    EXPECT_EQ(analysis.instrs[0].opcode(), OPX_BEGINBLOCK);
+    EXPECT_EQ(analysis.instrs[0].arg(), 0);
+    EXPECT_EQ(analysis.instrs[1].opcode(), OP_PUSH1);
+    EXPECT_EQ(analysis.instrs[1].arg(), 0x2a);
+    EXPECT_EQ(analysis.instrs[2].opcode(), OP_PUSH1);
+    EXPECT_EQ(analysis.instrs[2].arg(), 0x1e);
+    EXPECT_EQ(analysis.instrs[3].opcode(), OP_MSTORE8);
+    EXPECT_EQ(analysis.instrs[4].opcode(), OP_MSIZE);
+    EXPECT_EQ(analysis.instrs[5].opcode(), OP_PUSH1);
+    EXPECT_EQ(analysis.instrs[6].opcode(), OP_SSTORE);
+    EXPECT_EQ(analysis.instrs[7].opcode(), OP_STOP);
+
+    ASSERT_EQ(analysis.numbers.size(), 1);
+    EXPECT_EQ(analysis.instrs[6].arg(), 0);
+    EXPECT_EQ(analysis.numbers[0], 14);
+
+    ASSERT_EQ(analysis.blocks.size(), 1);
+    EXPECT_EQ(analysis.blocks[0].gas_cost, 14u);
+    EXPECT_EQ(analysis.blocks[0].stack_req, 0);
+    EXPECT_EQ(analysis.blocks[0].stack_max_growth, 2);
+}
+
+TEST(analysis, compact_push)
+{
+    const auto code = push(0x010203) + push(0x01020304) + push("0a0b0c0d0e0f101112") + OP_PC;
+    const auto analysis = analyze_compact(rev, code);
+
+    ASSERT_EQ(analysis.instrs.size(), 6);
+    EXPECT_EQ(analysis.instrs[1].arg(), 0x010203);
+    ASSERT_EQ(analysis.small_push_values.size(), 1);
+    EXPECT_EQ(analysis.instrs[2].arg(), 0);
+    EXPECT_EQ(analysis.small_push_values[0], 0x01020304);
+    ASSERT_EQ(analysis.push_values.size(), 1);
+    EXPECT_EQ(analysis.instrs[3].arg(), 0);
+    EXPECT_EQ(
+        analysis.push_values[0], intx::from_string<intx::uint256>("0x0a0b0c0d0e0f101112"));
+    EXPECT_EQ(analysis.instrs[4].opcode(), OP_PC);
+    EXPECT_EQ(analysis.instrs[4].arg(), 19);
+}
+
+TEST(analysis, compact_jumpi_jumpdest)
+{
+    const auto code = push(0) + OP_JUMPI + OP_JUMPDEST;
+    const auto analysis = analyze_compact(rev, code);
+
+    ASSERT_EQ(analysis.instrs.size(), 5);
+    ASSERT_EQ(analysis.blocks.size(), 3);
+    EXPECT_EQ(analysis.blocks[0].gas_cost, 3 + 10);
+    EXPECT_EQ(analysis.instrs[2].opcode(), OP_JUMPI);
+    EXPECT_EQ(analysis.instrs[2].arg(), 1);
+    EXPECT_EQ(analysis.blocks[1].gas_cost, 0);  // The block following JUMPI is empty.
+    EXPECT_EQ(analysis.instrs[3].opcode(), OP_JUMPDEST);
+    EXPECT_EQ(analysis.instrs[3].arg(), 2);
+    EXPECT_EQ(analysis.blocks[2].gas_cost, 1);
+
+    EXPECT_EQ(find_jumpdest(analysis, 3), 3);
+    EXPECT_EQ(find_jumpdest(analysis, 0), -1);
+}
+
+TEST(analysis, storage_reservation_dead_code)
+{
+    // The storage is reserved also for the instructions in dead code, but not for PUSH data.
+    const auto code = bytecode{OP_STOP} + push("000000000000000000") + push(0x20) + OP_JUMPDEST;
+    const auto sizes = count_instructions(code);
+    EXPECT_EQ(sizes.num_instrs, 4);
+    EXPECT_EQ(sizes.num_large_pushes, 1);
+
+    const auto analysis = analyze(rev, code);
+    ASSERT_EQ(analysis.instrs.size(), 4);
+    EXPECT_TRUE(analysis.push_values.empty());
+    EXPECT_GE(analysis.instrs.capacity(), sizes.num_instrs + 2);
+    EXPECT_GE(analysis.push_values.capacity(), sizes.num_large_pushes);
+}
+
+TEST(analysis, storage_not_reallocated)
+{
+    // All push values are placed in the storage reserved from the counted sizes
+    // so the pointers taken during the analysis remain valid.
+    bytecode code;
+    for (unsigned i = 0; i < 100; ++i)
+        code += push(intx::uint256{1} << (i + 100)) + OP_POP;
+    const auto sizes = count_instructions(code);
+    EXPECT_EQ(sizes.num_instrs, 200);
+    EXPECT_EQ(sizes.num_large_pushes, 100);
+
+    const auto analysis = analyze(rev, code);
+    ASSERT_EQ(analysis.push_values.size(), 100);
+    for (size_t i = 0; i < analysis.push_values.size(); ++i)
+    {
+        EXPECT_EQ(analysis.instrs[2 * i + 1].arg.push_value, &analysis.push_values[i]);
+        EXPECT_EQ(*analysis.instrs[2 * i + 1].arg.push_value, intx::uint256{1} << (i + 100));
+    }
+}
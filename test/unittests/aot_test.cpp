@@ -0,0 +1,171 @@
+// zvmone: Fast Zond Virtual Machine implementation
+// Copyright 2026 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+#include <test/utils/bytecode.hpp>
+#include <zvmc/mocked_host.hpp>
+#include <zvmone/aot_runtime.hpp>
+#include <zvmone/vm.hpp>
+#include <zvmone/zvmone.h>
+
+using namespace zvmone;
+using namespace zvmone::aot;
+
+namespace
+{
+/// The loop summing the numbers from 10 down to 1.
+const auto sum_code = push(0) + push(10) + OP_JUMPDEST + OP_DUP1 + OP_SWAP2 + OP_ADD + OP_SWAP1 +
+                      push(1) + OP_SWAP1 + OP_SUB + OP_DUP1 + push(4) + OP_JUMPI + OP_POP +
+                      ret_top();
+
+/// The sum_code compiled as by zvmone-aot. The generated source is in test/aot/sum.cpp.expected.
+int64_t sum_contract(const Context& ctx, int64_t gas) noexcept
+{
+    auto* stack_top = ctx.stack_bottom;
+    [[maybe_unused]] code_iterator next = nullptr;
+
+    if (!push<OP_PUSH1>(ctx, uint256{0}, stack_top, gas))
+        return gas;
+    if (!push<OP_PUSH1>(ctx, uint256{10}, stack_top, gas))
+        return gas;
+L4:
+    if ((next = step<OP_JUMPDEST>(ctx, 4, stack_top, gas)) == nullptr)
+        return gas;
+    if ((next = step<OP_DUP1>(ctx, 5, stack_top, gas)) == nullptr)
+        return gas;
+    if ((next = step<OP_SWAP2>(ctx, 6, stack_top, gas)) == nullptr)
+        return gas;
+    if ((next = step<OP_ADD>(ctx, 7, stack_top, gas)) == nullptr)
+        return gas;
+    if ((next = step<OP_SWAP1>(ctx, 8, stack_top, gas)) == nullptr)
+        return gas;
+    if (!push<OP_PUSH1>(ctx, uint256{1}, stack_top, gas))
+        return gas;
+    if ((next = step<OP_SWAP1>(ctx, 11, stack_top, gas)) == nullptr)
+        return gas;
+    if ((next = step<OP_SUB>(ctx, 12, stack_top, gas)) == nullptr)
+        return gas;
+    if ((next = step<OP_DUP1>(ctx, 13, stack_top, gas)) == nullptr)
+        return gas;
+    if (!push<OP_PUSH1>(ctx, uint256{4}, stack_top, gas))
+        return gas;
+    if ((next = step<OP_JUMPI>(ctx, 16, stack_top, gas)) == nullptr)
+        return gas;
+    if (next != &ctx.code[17])
+        goto dispatch;
+    if ((next = step<OP_POP>(ctx, 17, stack_top, gas)) == nullptr)
+        return gas;
+    if (!push<OP_PUSH1>(ctx, uint256{0}, stack_top, gas))
+        return gas;
+    if ((next = step<OP_MSTORE>(ctx, 20, stack_top, gas)) == nullptr)
+        return gas;
+    if (!push<OP_PUSH1>(ctx, uint256{32}, stack_top, gas))
+        return gas;
+    if (!push<OP_PUSH1>(ctx, uint256{0}, stack_top, gas))
+        return gas;
+    if ((next = step<OP_RETURN>(ctx, 25, stack_top, gas)) == nullptr)
+        return gas;
+    step<OP_STOP>(ctx, 26, stack_top, gas);
+    return gas;
+
+dispatch:
+    switch (next - ctx.code)
+    {
+    case 4:
+        goto L4;
+    default:
+        return gas;
+    }
+}
+
+const Contract contracts[] = {{sum_code.data(), sum_code.size(), sum_contract}};
+}  // namespace
+
+TEST(aot, registry)
+{
+    Registry registry;
+    EXPECT_FALSE(registry.add({abi_version + 1, std::size(contracts), contracts}));
+    EXPECT_EQ(registry.size(), 0);
+
+    EXPECT_TRUE(registry.add({abi_version, std::size(contracts), contracts}));
+    EXPECT_EQ(registry.size(), 1);
+
+    // The contracts are matched by the code, not the buffer.
+    const auto code_copy = bytecode{sum_code};
+    const auto* entry = registry.find(code_copy);
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry->fn, sum_contract);
+    EXPECT_EQ(entry->analysis.executable_code, bytes_view{sum_code});
+
+    EXPECT_EQ(registry.find(sum_code + OP_STOP), nullptr);
+}
+
+TEST(aot, load_directory_missing)
+{
+    Registry registry;
+    EXPECT_FALSE(registry.load_directory("/nonexistent/zvmone/aot"));
+}
+
+TEST(aot, execute)
+{
+    auto vm = zvmc::VM{zvmc_create_zvmone()};
+    auto& zvmone_vm = *static_cast<zvmone::VM*>(vm.get_raw_pointer());
+    EXPECT_EQ(vm.set_option("aot", "/nonexistent/zvmone/aot"), ZVMC_SET_OPTION_INVALID_VALUE);
+    EXPECT_FALSE(zvmone_vm.aot_registry);
+
+    zvmc::MockedHost host;
+    zvmc_message msg{};
+    msg.gas = 1000;
+    const auto expected = vm.execute(host, ZVMC_SHANGHAI, msg, sum_code.data(), sum_code.size());
+    ASSERT_EQ(expected.status_code, ZVMC_SUCCESS);
+
+    zvmone_vm.aot_registry = std::make_unique<Registry>();
+    ASSERT_TRUE(zvmone_vm.aot_registry->add({abi_version, std::size(contracts), contracts}));
+
+    const auto r = vm.execute(host, ZVMC_SHANGHAI, msg, sum_code.data(), sum_code.size());
+    ASSERT_EQ(r.status_code, ZVMC_SUCCESS);
+    EXPECT_EQ(r.gas_left, expected.gas_left);
+    ASSERT_EQ(r.output_size, 32);
+    EXPECT_EQ(r.output_data[31], 55);
+
+    // The out of gas is detected as in the interpreter.
+    msg.gas = 100;
+    const auto oog = vm.execute(host, ZVMC_SHANGHAI, msg, sum_code.data(), sum_code.size());
+    EXPECT_EQ(oog.status_code, ZVMC_OUT_OF_GAS);
+
+    EXPECT_EQ(vm.set_option("aot", ""), ZVMC_SET_OPTION_SUCCESS);
+    EXPECT_FALSE(zvmone_vm.aot_registry);
+}
+
+#ifdef ZVMONE_AOT_TEST_DIR
+TEST(aot, load_directory)
+{
+    // The directory contains test/aot/sum.hex compiled with zvmone-aot.
+    Registry registry;
+    ASSERT_TRUE(registry.load_directory(ZVMONE_AOT_TEST_DIR));
+    EXPECT_EQ(registry.size(), 1);
+    const auto* entry = registry.find(sum_code);
+    ASSERT_NE(entry, nullptr);
+    EXPECT_NE(entry->fn, sum_contract);
+
+    auto vm = zvmc::VM{zvmc_create_zvmone()};
+    auto& zvmone_vm = *static_cast<zvmone::VM*>(vm.get_raw_pointer());
+
+    zvmc::MockedHost host;
+    zvmc_message msg{};
+    msg.gas = 1000;
+    const auto expected = vm.execute(host, ZVMC_SHANGHAI, msg, sum_code.data(), sum_code.size());
+    ASSERT_EQ(expected.status_code, ZVMC_SUCCESS);
+
+    ASSERT_EQ(vm.set_option("aot", ZVMONE_AOT_TEST_DIR), ZVMC_SET_OPTION_SUCCESS);
+    ASSERT_TRUE(zvmone_vm.aot_registry);
+    EXPECT_NE(zvmone_vm.aot_registry->find(sum_code), nullptr);
+
+    const auto r = vm.execute(host, ZVMC_SHANGHAI, msg, sum_code.data(), sum_code.size());
+    ASSERT_EQ(r.status_code, ZVMC_SUCCESS);
+    EXPECT_EQ(r.gas_left, expected.gas_left);
+    ASSERT_EQ(r.output_size, 32);
+    EXPECT_EQ(r.output_data[31], 55);
+}
+#endif
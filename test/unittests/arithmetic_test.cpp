@@ -0,0 +1,145 @@
+// zvmone: Fast Zond Virtual Machine implementation
+// Copyright 2026 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+#include <zvmone/arithmetic.hpp>
+#include <vector>
+
+using namespace zvmone;
+using namespace intx;
+
+namespace
+{
+/// The values of all width classes including the edge cases of the fast paths.
+const intx::uint256 test_values[]{
+    0,
+    1,
+    2,
+    3,
+    0x7fffffffffffffff,
+    0x8000000000000000,
+    0xfedcba9876543210,
+    0xffffffffffffffff,
+    0x10000000000000000_u256,
+    0x9a3c2b1d4e5f6a7b8c_u256,
+    0x7fffffffffffffffffffffffffffffff_u256,
+    0xe1b4a7f3c2d5e6f7a8b9cadbecfd0e1f_u256,
+    0x100000000000000000000000000000000_u256,
+    0x9a3c2b1d4e5f6a7b8c9dae0f1021324354657687_u256,
+    0x7fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff_u256,
+    0x8000000000000000000000000000000000000000000000000000000000000000_u256,
+    0xffffffffffffffffffffffffffffffffffffffffffffffff8000000000000000_u256,  // INT64_MIN
+    0xfffffffffffffffffffffffffffffffffffffffffffffffffedcba9876543210_u256,
+    0xffffffffffffffffffffffffffffffffffffffffffffffff7fffffffffffffff_u256,
+    0xfffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffe_u256,
+    0xffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff_u256,
+};
+}  // namespace
+
+TEST(arithmetic, div_mod)
+{
+    for (const auto& x : test_values)
+    {
+        for (const auto& y : test_values)
+        {
+            if (y == 0)
+                continue;
+            EXPECT_EQ(arith::div(x, y), x / y) << hex(x) << " / " << hex(y);
+            EXPECT_EQ(arith::mod(x, y), x % y) << hex(x) << " % " << hex(y);
+            const auto [quot, rem] = intx::sdivrem(x, y);
+            EXPECT_EQ(arith::sdiv(x, y), quot) << hex(x) << " sdiv " << hex(y);
+            EXPECT_EQ(arith::smod(x, y), rem) << hex(x) << " smod " << hex(y);
+        }
+    }
+}
+
+TEST(arithmetic, addmod_mulmod)
+{
+    for (const auto& x : test_values)
+    {
+        for (const auto& y : test_values)
+        {
+            for (const auto& m : test_values)
+            {
+                if (m == 0)
+                    continue;
+                EXPECT_EQ(arith::addmod(x, y, m), intx::addmod(x, y, m))
+                    << hex(x) << " + " << hex(y) << " % " << hex(m);
+                EXPECT_EQ(arith::mulmod(x, y, m), intx::mulmod(x, y, m))
+                    << hex(x) << " * " << hex(y) << " % " << hex(m);
+            }
+        }
+    }
+}
+
+TEST(arithmetic, exp)
+{
+    std::vector<intx::uint256> bases{std::begin(test_values), std::end(test_values)};
+    for (unsigned k = 0; k < 256; ++k)
+        bases.push_back(intx::uint256{1} << k);
+
+    std::vector<intx::uint256> exponents{std::begin(test_values), std::end(test_values)};
+    for (uint64_t e = 4; e <= 40; ++e)
+        exponents.push_back(e);
+    exponents.insert(exponents.end(), {63, 64, 85, 128, 255, 256, 257, 1000, 0xffffffff});
+
+    for (const auto& base : bases)
+    {
+        for (const auto& exponent : exponents)
+        {
+            EXPECT_EQ(arith::exp(base, exponent), intx::exp(base, exponent))
+                << hex(base) << " ** " << hex(exponent);
+        }
+    }
+}
+
+TEST(arithmetic, barrett_reducer)
+{
+    for (const auto& m : test_values)
+    {
+        if (m == 0)
+            continue;
+        const arith::BarrettReducer reducer{m};
+        for (const auto& a : test_values)
+        {
+            for (const auto& b : test_values)
+            {
+                const auto x = a % m;
+                const auto y = b % m;
+                EXPECT_EQ(reducer.mulmod(x, y), intx::mulmod(x, y, m))
+                    << hex(x) << " * " << hex(y) << " % " << hex(m);
+            }
+        }
+    }
+}
+
+TEST(arithmetic, modulus_cache)
+{
+    arith::ModulusCache cache;
+    const auto m1 = 0xfffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2f_u256;
+    const auto m2 = 0x30644e72e131a029b85045b68181585d97816a916871ca8d3c208c16d87cfd47_u256;
+
+    EXPECT_EQ(cache.get(m1), nullptr);
+    const auto* const r1 = cache.get(m1);
+    ASSERT_NE(r1, nullptr);
+    EXPECT_EQ(cache.get(m1), r1);
+
+    EXPECT_EQ(cache.get(m2), nullptr);
+    EXPECT_NE(cache.get(m2), nullptr);
+    EXPECT_EQ(cache.get(m1), r1);
+
+    // The oldest modulus is replaced by the new ones.
+    for (uint64_t m = 1; m <= 4; ++m)
+        EXPECT_EQ(cache.get(m), nullptr);
+    EXPECT_EQ(cache.get(m1), nullptr);
+
+    cache.clear();
+    EXPECT_EQ(cache.get(4), nullptr);
+
+    // The repeated modulus uses the reduction with the identical results.
+    const auto x = m2 - 1;
+    const auto y = m2 / 3;
+    for (int i = 0; i < 3; ++i)
+        EXPECT_EQ(arith::mulmod(x, y, m2, cache), intx::mulmod(x, y, m2));
+}
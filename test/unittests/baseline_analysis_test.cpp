@@ -0,0 +1,261 @@
+// zvmone: Fast Zond Virtual Machine implementation
+// Copyright 2026 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+#include <test/utils/bytecode.hpp>
+#include <zvmone/baseline.hpp>
+#include <zvmone/instructions_traits.hpp>
+#include <zvmone/jumpdest_analysis.hpp>
+#include <vector>
+
+using namespace zvmone::baseline;
+
+constexpr auto rev = ZVMC_SHANGHAI;
+
+TEST(baseline_analysis, empty)
+{
+    const auto analysis = analyze(rev, {});
+    EXPECT_EQ(analysis.executable_code.size(), 0);
+    EXPECT_EQ(analysis.executable_code.data()[0], OP_STOP);
+}
+
+TEST(baseline_analysis, padding)
+{
+    const auto code = bytecode{OP_PUSH32};
+    const auto analysis = analyze(rev, code);
+    ASSERT_EQ(analysis.executable_code, code);
+
+    // The missing PUSH data and the terminating STOP.
+    for (size_t i = 0; i < 33; ++i)
+        EXPECT_EQ(analysis.executable_code.data()[code.size() + i], OP_STOP) << i;
+}
+
+TEST(baseline_analysis, jumpdests)
+{
+    const auto code = OP_JUMPDEST + push(0x5b) + OP_JUMPDEST + push("5b5b") + OP_JUMPDEST;
+    const auto analysis = analyze(rev, code);
+    ASSERT_EQ(analysis.executable_code, code);
+
+    EXPECT_TRUE(analysis.check_jumpdest(0));
+    EXPECT_FALSE(analysis.check_jumpdest(1));
+    EXPECT_FALSE(analysis.check_jumpdest(2));  // PUSH data.
+    EXPECT_TRUE(analysis.check_jumpdest(3));
+    EXPECT_FALSE(analysis.check_jumpdest(4));
+    EXPECT_FALSE(analysis.check_jumpdest(5));  // PUSH data.
+    EXPECT_FALSE(analysis.check_jumpdest(6));  // PUSH data.
+    EXPECT_TRUE(analysis.check_jumpdest(7));
+}
+
+TEST(baseline_analysis, jumpdests_across_words)
+{
+    const auto code = 63 * OP_JUMPDEST + push("5b5b") + 130 * OP_JUMPDEST;
+    const auto analysis = analyze(rev, code);
+    ASSERT_EQ(analysis.executable_code, code);
+
+    for (size_t i = 0; i < code.size(); ++i)
+    {
+        const auto in_push_data = i == 64 || i == 65;
+        EXPECT_EQ(analysis.check_jumpdest(i), i != 63 && !in_push_data) << i;
+    }
+}
+
+TEST(baseline_analysis, chunked_matches_bytewise)
+{
+    // Pseudo-random code with high density of PUSH and JUMPDEST instructions,
+    // including PUSH data crossing the 64-byte chunk boundaries.
+    uint32_t seed = 1;
+    const auto next = [&seed] { return seed = seed * 1103515245 + 12345; };
+
+    for (size_t size = 0; size < 300; ++size)
+    {
+        zvmone::bytes code(size, 0);
+        for (auto& c : code)
+        {
+            const auto r = next() >> 16;
+            if (r % 3 == 0)
+                c = OP_JUMPDEST;
+            else if (r % 3 == 1)
+                c = static_cast<uint8_t>(OP_PUSH1 + (r >> 2) % 32);
+            else
+                c = static_cast<uint8_t>(r >> 8);
+        }
+
+        const auto bitmap_size = CodeAnalysis::bitmap_size(size);
+        std::vector<uint64_t> expected(bitmap_size);
+        std::vector<uint64_t> bitmap(bitmap_size);
+        analyze_jumpdests_bytewise(code, expected.data());
+        analyze_jumpdests_chunked(code, bitmap.data());
+        EXPECT_EQ(bitmap, expected) << size;
+    }
+}
+
+TEST(baseline_analysis, chunked_range_matches_bytewise)
+{
+    // The code with the PUSH data crossing the chunk boundaries analyzed in ranges.
+    const auto code = 60 * OP_JUMPDEST + push("5b5b5b5b5b5b5b5b") + 50 * OP_JUMPDEST +
+                      push(OP_PUSH32, 32 * OP_JUMPDEST) + 100 * OP_JUMPDEST;
+
+    const auto bitmap_size = CodeAnalysis::bitmap_size(code.size());
+    std::vector<uint64_t> expected(bitmap_size);
+    std::vector<uint64_t> bitmap(bitmap_size);
+    analyze_jumpdests_bytewise(code, expected.data());
+
+    size_t carry = 0;
+    for (size_t i = 0; i < bitmap_size; ++i)
+        carry = analyze_jumpdests_chunked(code, bitmap.data(), i, i + 1, carry);
+    EXPECT_EQ(carry, 0);
+    EXPECT_EQ(bitmap, expected);
+}
+
+TEST(baseline_analysis, lazy_jumpdests)
+{
+    const auto code = OP_JUMPDEST + push("5b5b") + 1000 * OP_JUMPDEST + push(0x5b) + OP_JUMPDEST;
+    const auto analysis = analyze(rev, code, {.lazy_jumpdests = true});
+    EXPECT_TRUE(analysis.is_jumpdest_analysis_partial());
+
+    EXPECT_TRUE(analysis.check_jumpdest(0));
+    EXPECT_FALSE(analysis.check_jumpdest(2));  // PUSH data.
+    EXPECT_TRUE(analysis.is_jumpdest_analysis_partial());
+
+    // No PUSH reaches the last JUMPDEST so it is checked without analyzing the code before it.
+    const auto last = code.size() - 1;
+    EXPECT_TRUE(analysis.check_jumpdest(last));
+    EXPECT_TRUE(analysis.is_jumpdest_analysis_partial());
+    EXPECT_FALSE(analysis.check_jumpdest(last - 1));  // PUSH data.
+    EXPECT_FALSE(analysis.is_jumpdest_analysis_partial());
+
+    const auto full = analyze(rev, code);
+    EXPECT_FALSE(full.is_jumpdest_analysis_partial());
+    for (size_t i = 0; i < code.size(); ++i)
+        EXPECT_EQ(analysis.check_jumpdest(i), full.check_jumpdest(i)) << i;
+}
+
+TEST(baseline_analysis, lazy_jumpdests_push_data_window)
+{
+    // The PUSH opcode bytes within 32 bytes before the JUMPDEST reaching it require
+    // the analysis of the code before it: they may be real PUSH instructions or PUSH data.
+    const auto pushed = 1000 * OP_JUMPDEST + OP_PUSH2 + OP_JUMPDEST + OP_JUMPDEST;
+    const auto not_pushed = 1000 * OP_JUMPDEST + OP_PUSH1 + OP_PUSH2 + OP_JUMPDEST;
+
+    for (const auto& [code, valid] : {std::pair{pushed, false}, std::pair{not_pushed, true}})
+    {
+        const auto analysis = analyze(rev, code, {.lazy_jumpdests = true});
+        const auto full = analyze(rev, code);
+
+        const auto last = code.size() - 1;
+        EXPECT_EQ(analysis.check_jumpdest(last), valid);
+        EXPECT_FALSE(analysis.is_jumpdest_analysis_partial());
+        for (size_t i = 0; i < code.size(); ++i)
+            EXPECT_EQ(analysis.check_jumpdest(i), full.check_jumpdest(i)) << i;
+    }
+}
+
+TEST(baseline_analysis, lazy_jumpdests_with_fusion)
+{
+    // The lazy analysis is not used for the fused code.
+    const auto code = push(1) + OP_ADD + OP_JUMPDEST;
+    const auto analysis = analyze(rev, code, {.fusion = true, .lazy_jumpdests = true});
+    EXPECT_TRUE(analysis.is_fused());
+    EXPECT_FALSE(analysis.is_jumpdest_analysis_partial());
+    EXPECT_TRUE(analysis.check_jumpdest(3));
+}
+
+TEST(baseline_analysis, no_block_requirements)
+{
+    const auto analysis = analyze(rev, push(1) + OP_JUMPDEST);
+    EXPECT_FALSE(analysis.has_block_requirements());
+}
+
+TEST(baseline_analysis, block_requirements)
+{
+    // 0: PUSH1 2; 2: JUMPDEST; 3: DUP1; 4: GAS; 5: POP; 6: JUMPI; 7: JUMPDEST; 8: STOP; 9: ADD
+    const auto code = push(2) + OP_JUMPDEST + OP_DUP1 + OP_GAS + OP_POP + OP_JUMPI + OP_JUMPDEST +
+                      OP_STOP + OP_ADD;
+    const auto analysis = analyze(rev, code, {.block_requirements = true});
+    ASSERT_TRUE(analysis.has_block_requirements());
+
+    const auto& b0 = analysis.block_requirements(0);
+    EXPECT_EQ(b0.gas_cost, 3);
+    EXPECT_EQ(b0.stack_req, 0);
+    EXPECT_EQ(b0.stack_max_growth, 1);
+
+    // The block ends at GAS.
+    const auto& b2 = analysis.block_requirements(2);
+    EXPECT_EQ(b2.gas_cost, 1 + 3 + 2);
+    EXPECT_EQ(b2.stack_req, 1);
+    EXPECT_EQ(b2.stack_max_growth, 2);
+
+    const auto& b5 = analysis.block_requirements(5);
+    EXPECT_EQ(b5.gas_cost, 2 + 10);
+    EXPECT_EQ(b5.stack_req, 3);
+    EXPECT_EQ(b5.stack_max_growth, 0);
+
+    // The JUMPDEST right after JUMPI does not create an empty block.
+    const auto& b7 = analysis.block_requirements(7);
+    EXPECT_EQ(b7.gas_cost, 1);
+    EXPECT_EQ(b7.stack_req, 0);
+
+    // The dead block after STOP.
+    const auto& b9 = analysis.block_requirements(9);
+    EXPECT_EQ(b9.gas_cost, 3);
+    EXPECT_EQ(b9.stack_req, 2);
+}
+
+TEST(baseline_analysis, block_requirements_at_code_end)
+{
+    const auto code = push(0) + push(0) + OP_JUMPI;
+    const auto analysis = analyze(rev, code, {.block_requirements = true});
+    ASSERT_TRUE(analysis.has_block_requirements());
+
+    const auto& end_block = analysis.block_requirements(code.size());
+    EXPECT_EQ(end_block.gas_cost, 0);
+    EXPECT_EQ(end_block.stack_req, 0);
+    EXPECT_EQ(end_block.stack_max_growth, 0);
+}
+
+TEST(baseline_analysis, no_fusion)
+{
+    const auto code = push(1) + OP_ADD;
+    const auto analysis = analyze(rev, code);
+    EXPECT_FALSE(analysis.is_fused());
+    EXPECT_EQ(analysis.executable_code, code);
+}
+
+TEST(baseline_analysis, fusion)
+{
+    // 0: PUSH1 1; 2: ADD; 3: JUMPDEST; 4: POP; 5: POP; 6: PUSH2 3; 9: JUMP
+    const auto code = push(1) + OP_ADD + OP_JUMPDEST + OP_POP + OP_POP + "61 0003 56";
+    const auto analysis = analyze(rev, code, {.fusion = true});
+    ASSERT_TRUE(analysis.is_fused());
+
+    const auto& fused_code = analysis.executable_code;
+    ASSERT_EQ(fused_code.size(), code.size());
+    EXPECT_EQ(fused_code[0], 0xb0);  // PUSH1 ADD
+    EXPECT_EQ(fused_code[1], code[1]);
+    EXPECT_EQ(fused_code[2], OP_ADD);
+    EXPECT_EQ(fused_code[3], OP_JUMPDEST);
+    EXPECT_EQ(fused_code[4], 0xb4);  // POP POP
+    EXPECT_EQ(fused_code[5], OP_POP);
+    EXPECT_EQ(fused_code[6], 0xb5);  // PUSH2 JUMP
+    EXPECT_EQ(fused_code.substr(7), code.substr(7));
+
+    // The jump destinations are not affected.
+    EXPECT_TRUE(analysis.check_jumpdest(3));
+    EXPECT_FALSE(analysis.check_jumpdest(0));
+}
+
+TEST(baseline_analysis, fusion_of_fused_opcode)
+{
+    // The fused opcode present in the original code remains undefined.
+    // The PUSH data and incomplete sequences at the code end are not modified.
+    const auto code = bytecode{"b0"} + push(0xb0) + OP_POP + push(1);
+    const auto analysis = analyze(rev, code, {.fusion = true});
+    EXPECT_FALSE(analysis.is_fused());
+
+    const auto& fused_code = analysis.executable_code;
+    ASSERT_EQ(fused_code.size(), code.size());
+    EXPECT_NE(fused_code[0], 0xb0);
+    EXPECT_EQ(zvmone::instr::traits[fused_code[0]].name, nullptr);
+    EXPECT_EQ(fused_code.substr(1), code.substr(1));
+}
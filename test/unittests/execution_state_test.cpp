@@ -5,6 +5,8 @@
 #include <gtest/gtest.h>
 #include <zvmone/advanced_analysis.hpp>
 #include <zvmone/execution_state.hpp>
+#include <zvmone/execution_state_pool.hpp>
+#include <algorithm>
 #include <type_traits>
 
 static_assert(std::is_default_constructible_v<zvmone::ExecutionState>);
@@ -172,3 +174,109 @@ TEST(execution_state, memory_view)
     EXPECT_EQ(view[1], 0x00);
     EXPECT_EQ(view[2], 0xc2);
 }
+
+TEST(execution_state, memory_grow_after_clear)
+{
+    zvmone::Memory memory;
+    memory.grow(64);
+    std::fill_n(&memory[0], memory.size(), uint8_t{0xff});
+
+    // Grow beyond the initial capacity to move the memory contents.
+    const auto size = 4 * memory.capacity();
+    memory.grow(size);
+    EXPECT_EQ(memory[63], 0xff);
+    EXPECT_EQ(static_cast<size_t>(std::count(memory.data(), memory.data() + size, 0)), size - 64);
+    std::fill_n(&memory[0], memory.size(), uint8_t{0xff});
+
+    memory.clear();
+    memory.grow(size);
+    EXPECT_EQ(static_cast<size_t>(std::count(memory.data(), memory.data() + size, 0)), size);
+}
+
+TEST(execution_state, pool_reuse)
+{
+    zvmone::ExecutionStatePool<zvmone::advanced::AdvancedExecutionState> pool;
+    const zvmc_host_interface host_interface{};
+    zvmc_message msg{};
+    msg.gas = 10;
+
+    const zvmone::advanced::AdvancedExecutionState* first = nullptr;
+    {
+        const auto st = pool.acquire(msg, ZVMC_SHANGHAI, host_interface, nullptr, {});
+        st->stack.push({});
+        st->memory.grow(64);
+        st->status = ZVMC_FAILURE;
+        first = st.get();
+    }
+    EXPECT_EQ(pool.num_idle(), 1);
+
+    msg.gas = 20;
+    const auto st = pool.acquire(msg, ZVMC_SHANGHAI, host_interface, nullptr, {});
+    EXPECT_EQ(st.get(), first);
+    EXPECT_EQ(pool.num_idle(), 0);
+    EXPECT_EQ(st->gas_left, 20);
+    EXPECT_EQ(st->stack.size(), 0);
+    EXPECT_EQ(st->memory.size(), 0);
+    EXPECT_EQ(st->status, ZVMC_SUCCESS);
+}
+
+TEST(execution_state, pool_depths)
+{
+    zvmone::ExecutionStatePool<zvmone::ExecutionState> pool;
+    const zvmc_host_interface host_interface{};
+    zvmc_message msg0{};
+    zvmc_message msg1{};
+    msg1.depth = 1;
+
+    {
+        const auto st0 = pool.acquire(msg0, ZVMC_SHANGHAI, host_interface, nullptr, {});
+        const auto st1 = pool.acquire(msg1, ZVMC_SHANGHAI, host_interface, nullptr, {});
+        EXPECT_NE(st0.get(), st1.get());
+
+        // The depth 0 is reentered: a new state is created.
+        const auto st0_reentered = pool.acquire(msg0, ZVMC_SHANGHAI, host_interface, nullptr, {});
+        EXPECT_NE(st0.get(), st0_reentered.get());
+    }
+    EXPECT_EQ(pool.num_idle(), 2);
+}
+
+TEST(execution_state, pool_large_memory_not_retained)
+{
+    zvmone::ExecutionStatePool<zvmone::ExecutionState> pool;
+    const zvmc_host_interface host_interface{};
+    const zvmc_message msg{};
+
+    {
+        const auto st = pool.acquire(msg, ZVMC_SHANGHAI, host_interface, nullptr, {});
+        st->memory.grow(pool.max_retained_memory + 32);
+    }
+    EXPECT_EQ(pool.num_idle(), 0);
+}
+
+TEST(execution_state, pool_retained_bytes_limit)
+{
+    using State = zvmone::ExecutionState;
+    zvmone::ExecutionStatePool<State> pool;
+    const zvmc_host_interface host_interface{};
+    zvmc_message msg{};
+
+    for (size_t depth = 0; depth <= pool.max_depth; ++depth)
+    {
+        msg.depth = static_cast<int32_t>(depth);
+        const auto st = pool.acquire(msg, ZVMC_SHANGHAI, host_interface, nullptr, {});
+        st->memory.grow(64);
+    }
+    EXPECT_LE(pool.retained_bytes(), pool.max_retained_bytes);
+    EXPECT_GT(pool.num_idle(), 0);
+    EXPECT_LT(pool.num_idle(), pool.max_depth + 1);
+    EXPECT_GE(pool.retained_bytes(), pool.num_idle() * sizeof(State));
+
+    // The reused state is not counted as retained while leased.
+    msg.depth = 0;
+    const auto retained_bytes = pool.retained_bytes();
+    {
+        const auto st = pool.acquire(msg, ZVMC_SHANGHAI, host_interface, nullptr, {});
+        EXPECT_LT(pool.retained_bytes(), retained_bytes);
+    }
+    EXPECT_EQ(pool.retained_bytes(), retained_bytes);
+}
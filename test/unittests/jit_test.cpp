@@ -0,0 +1,195 @@
+// zvmone: Fast Zond Virtual Machine implementation
+// Copyright 2026 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+#include <test/utils/bytecode.hpp>
+#include <zvmc/mocked_host.hpp>
+#include <zvmone/jit.hpp>
+#include <zvmone/vm.hpp>
+#include <zvmone/zvmone.h>
+
+using namespace zvmone;
+
+namespace
+{
+int num_compilations = 0;
+
+/// The fake compilation producing the code without the native code.
+std::shared_ptr<const jit::CompiledCode> counting_compile(zvmc_revision rev, bytes_view code)
+{
+    ++num_compilations;
+    return std::make_shared<const jit::CompiledCode>(
+        jit::CompiledCode{baseline::analyze(rev, code), {}, {}});
+}
+
+std::shared_ptr<const jit::CompiledCode> failing_compile(zvmc_revision /*rev*/, bytes_view /*code*/)
+{
+    ++num_compilations;
+    return nullptr;
+}
+}  // namespace
+
+TEST(jit, tier_threshold)
+{
+    num_compilations = 0;
+    jit::Tier tier{3};
+    const auto code = push(1) + push(2) + OP_ADD;
+
+    EXPECT_EQ(tier.get(ZVMC_SHANGHAI, code, counting_compile), nullptr);
+    EXPECT_EQ(tier.get(ZVMC_SHANGHAI, code, counting_compile), nullptr);
+    EXPECT_EQ(num_compilations, 0);
+
+    const auto c1 = tier.get(ZVMC_SHANGHAI, code, counting_compile);
+    ASSERT_NE(c1, nullptr);
+    EXPECT_EQ(c1->analysis.executable_code.size(), code.size());
+    EXPECT_EQ(tier.get(ZVMC_SHANGHAI, code, counting_compile), c1);
+    EXPECT_EQ(num_compilations, 1);
+    EXPECT_EQ(tier.num_compiled(), 1);
+}
+
+TEST(jit, tier_compile_failure)
+{
+    num_compilations = 0;
+    jit::Tier tier{1};
+    const auto code = bytecode{OP_STOP};
+
+    for (int i = 0; i < 3; ++i)
+        EXPECT_EQ(tier.get(ZVMC_SHANGHAI, code, failing_compile), nullptr);
+    EXPECT_EQ(num_compilations, 1);
+    EXPECT_EQ(tier.num_compiled(), 0);
+}
+
+TEST(jit, tier_capacity)
+{
+    num_compilations = 0;
+    jit::Tier tier{1, 1};
+
+    EXPECT_NE(tier.get(ZVMC_SHANGHAI, push(1), counting_compile), nullptr);
+    EXPECT_EQ(tier.get(ZVMC_SHANGHAI, push(2), counting_compile), nullptr);
+    EXPECT_EQ(num_compilations, 1);
+}
+
+TEST(jit, vm_option)
+{
+    auto vm = zvmc::VM{zvmc_create_zvmone()};
+    auto& zvmone_vm = *static_cast<zvmone::VM*>(vm.get_raw_pointer());
+    EXPECT_FALSE(zvmone_vm.jit_tier);
+
+#if ZVMONE_JIT_SUPPORTED
+    EXPECT_EQ(vm.set_option("jit", ""), ZVMC_SET_OPTION_INVALID_VALUE);
+    EXPECT_EQ(vm.set_option("jit", "x"), ZVMC_SET_OPTION_INVALID_VALUE);
+
+    ASSERT_EQ(vm.set_option("jit", "2"), ZVMC_SET_OPTION_SUCCESS);
+    ASSERT_TRUE(zvmone_vm.jit_tier);
+
+    zvmc::MockedHost host;
+    zvmc_message msg{};
+    msg.gas = 1000;
+
+    // The loop summing the numbers from 10 down to 1.
+    const auto code = push(0) + push(10) + OP_JUMPDEST + OP_DUP1 + OP_SWAP2 + OP_ADD + OP_SWAP1 +
+                      push(1) + OP_SWAP1 + OP_SUB + OP_DUP1 + push(4) + OP_JUMPI + OP_POP +
+                      ret_top();
+    int64_t gas_left = 0;
+    for (int i = 0; i < 3; ++i)
+    {
+        const auto r = vm.execute(host, ZVMC_SHANGHAI, msg, code.data(), code.size());
+        ASSERT_EQ(r.status_code, ZVMC_SUCCESS);
+        ASSERT_EQ(r.output_size, 32);
+        EXPECT_EQ(r.output_data[31], 55);
+        if (i != 0)
+            EXPECT_EQ(r.gas_left, gas_left);
+        gas_left = r.gas_left;
+    }
+    EXPECT_EQ(zvmone_vm.jit_tier->num_compiled(), 1);
+
+    EXPECT_EQ(vm.set_option("jit", "0"), ZVMC_SET_OPTION_SUCCESS);
+    EXPECT_FALSE(zvmone_vm.jit_tier);
+#else
+    EXPECT_EQ(vm.set_option("jit", "1"), ZVMC_SET_OPTION_INVALID_NAME);
+#endif
+}
+
+#if ZVMONE_JIT_SUPPORTED
+TEST(jit, jumpdest_loop_out_of_gas)
+{
+    auto vm = zvmc::VM{zvmc_create_zvmone(), {{"jit", "1"}}};
+    const auto& zvmone_vm = *static_cast<zvmone::VM*>(vm.get_raw_pointer());
+
+    zvmc::MockedHost host;
+    zvmc_message msg{};
+    msg.gas = 100000;
+
+    // The block started by the JUMPDEST is charged on every iteration.
+    const auto code = bytecode{OP_JUMPDEST} + push(0) + OP_JUMP;
+    const auto r = vm.execute(host, ZVMC_SHANGHAI, msg, code.data(), code.size());
+    EXPECT_EQ(r.status_code, ZVMC_OUT_OF_GAS);
+    EXPECT_EQ(r.gas_left, 0);
+    EXPECT_EQ(zvmone_vm.jit_tier->num_compiled(), 1);
+}
+
+TEST(jit, jumpdest_loop_stack_overflow)
+{
+    auto vm = zvmc::VM{zvmc_create_zvmone(), {{"jit", "1"}}};
+    const auto& zvmone_vm = *static_cast<zvmone::VM*>(vm.get_raw_pointer());
+
+    zvmc::MockedHost host;
+    zvmc_message msg{};
+    msg.gas = 1000000;
+
+    // The block started by the JUMPDEST checks the stack height on every iteration.
+    const auto code = bytecode{OP_JUMPDEST} + push(1) + push(0) + OP_JUMP;
+    const auto r = vm.execute(host, ZVMC_SHANGHAI, msg, code.data(), code.size());
+    EXPECT_EQ(r.status_code, ZVMC_STACK_OVERFLOW);
+    EXPECT_EQ(zvmone_vm.jit_tier->num_compiled(), 1);
+}
+
+TEST(jit, native_instructions)
+{
+    auto baseline_vm = zvmc::VM{zvmc_create_zvmone()};
+    auto jit_vm = zvmc::VM{zvmc_create_zvmone(), {{"jit", "1"}}};
+
+    zvmc::MockedHost host;
+    zvmc_message msg{};
+    msg.gas = 1000000;
+
+    // The operands with the carries and the borrows between the words, and the different signs.
+    const char* const operands[]{"00", "01",
+        "ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff",
+        "8000000000000000000000000000000000000000000000000000000000000000",
+        "7fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff",
+        "ffffffffffffffff0000000000000000ffffffffffffffff",
+        "fffffffffffffffe0000000000000000ffffffffffffffff"};
+
+    // The instructions emitted as the stencils or the direct calls of the implementations.
+    for (const auto op : {OP_ADD, OP_SUB, OP_MUL, OP_AND, OP_OR, OP_XOR, OP_LT, OP_GT, OP_SLT,
+             OP_SGT, OP_EQ, OP_SHL, OP_SAR, OP_ADDMOD, OP_NOT, OP_ISZERO})
+    {
+        bytecode code;
+        int n = 0;
+        for (const auto x : operands)
+        {
+            for (const auto y : operands)
+            {
+                code += push("1234") + push(y) + push(x) + op;
+                if (instr::traits[op].stack_height_change == -2)
+                    code += OP_DUP1;  // Keep the stack height the same for all instructions.
+                else if (instr::traits[op].stack_height_change == 0)
+                    code += OP_SWAP1 + OP_POP;
+                code += mstore(32 * n++) + OP_POP;
+            }
+        }
+        code += ret(0, 32 * n);
+
+        const auto expected =
+            baseline_vm.execute(host, ZVMC_SHANGHAI, msg, code.data(), code.size());
+        const auto r = jit_vm.execute(host, ZVMC_SHANGHAI, msg, code.data(), code.size());
+        ASSERT_EQ(r.status_code, ZVMC_SUCCESS) << instr::traits[op].name;
+        EXPECT_EQ(r.gas_left, expected.gas_left) << instr::traits[op].name;
+        EXPECT_EQ(hex({r.output_data, r.output_size}),
+            hex({expected.output_data, expected.output_size}))
+            << instr::traits[op].name;
+    }
+}
+#endif
@@ -0,0 +1,102 @@
+// zvmone: Fast Zond Virtual Machine implementation
+// Copyright 2026 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+#include <test/utils/bytecode.hpp>
+#include <zvmc/mocked_host.hpp>
+#include <zvmone/keccak_cache.hpp>
+#include <zvmone/vm.hpp>
+#include <zvmone/zvmone.h>
+#include <cstring>
+
+using namespace zvmone;
+
+namespace
+{
+bool digests_equal(const ethash::hash256& a, const ethash::hash256& b) noexcept
+{
+    return std::memcmp(a.bytes, b.bytes, sizeof(a.bytes)) == 0;
+}
+}  // namespace
+
+TEST(keccak_cache, hits_and_misses)
+{
+    Keccak256Cache cache;
+    uint8_t input[Keccak256Cache::max_input_size]{};
+    input[31] = 0x01;
+    input[63] = 0x02;
+
+    for (const size_t size : {size_t{1}, size_t{32}, size_t{63}, size_t{64}})
+    {
+        EXPECT_TRUE(digests_equal(cache.keccak256(input, size), ethash::keccak256(input, size)));
+        EXPECT_TRUE(digests_equal(cache.keccak256(input, size), ethash::keccak256(input, size)));
+    }
+    EXPECT_EQ(cache.stats().misses, 4);
+    EXPECT_EQ(cache.stats().hits, 4);
+
+    // The modified input is not served from the cache.
+    input[0] = 0xff;
+    EXPECT_TRUE(digests_equal(cache.keccak256(input, 64), ethash::keccak256(input, 64)));
+    EXPECT_EQ(cache.stats().misses, 5);
+    EXPECT_TRUE(digests_equal(cache.keccak256(input, 64), ethash::keccak256(input, 64)));
+    EXPECT_EQ(cache.stats().hits, 5);
+}
+
+TEST(keccak_cache, clear)
+{
+    Keccak256Cache cache;
+    const uint8_t input[]{0x01, 0x02, 0x03};
+
+    (void)cache.keccak256(input, sizeof(input));
+    (void)cache.keccak256(input, sizeof(input));
+    EXPECT_EQ(cache.stats().hits, 1);
+
+    cache.clear();
+    EXPECT_TRUE(digests_equal(
+        cache.keccak256(input, sizeof(input)), ethash::keccak256(input, sizeof(input))));
+    EXPECT_EQ(cache.stats().hits, 1);
+    EXPECT_EQ(cache.stats().misses, 2);
+}
+
+TEST(keccak_cache, vm_option)
+{
+    auto vm = zvmc::VM{zvmc_create_zvmone()};
+    auto& zvmone_vm = *static_cast<zvmone::VM*>(vm.get_raw_pointer());
+    EXPECT_FALSE(zvmone_vm.keccak_cache);
+    ASSERT_EQ(vm.set_option("keccak_cache", "yes"), ZVMC_SET_OPTION_SUCCESS);
+    EXPECT_TRUE(zvmone_vm.keccak_cache);
+
+    zvmc::MockedHost host;
+    zvmc_message msg{};
+    msg.gas = 100000;
+
+    // The keccak256(key . slot) of the mapping element computed twice, then for another key.
+    const auto code = mstore(0, 0xaa) + mstore(32, 0x01) + keccak256(0, 64) + mstore(64) +
+                      keccak256(0, 64) + mstore(96) + mstore(0, 0xbb) + keccak256(0, 64) +
+                      mstore(128) + ret(64, 96);
+
+    uint8_t input[64]{};
+    input[31] = 0xaa;
+    input[63] = 0x01;
+    const auto digest1 = ethash::keccak256(input, sizeof(input));
+    input[31] = 0xbb;
+    const auto digest2 = ethash::keccak256(input, sizeof(input));
+
+    const auto& stats = Keccak256Cache::get_thread_local().stats();
+    const auto hits_before = stats.hits;
+    const auto misses_before = stats.misses;
+
+    // The digests cached in the first transaction are not reused in the second one.
+    for (int i = 0; i < 2; ++i)
+    {
+        const auto r = vm.execute(host, ZVMC_SHANGHAI, msg, code.data(), code.size());
+        ASSERT_EQ(r.status_code, ZVMC_SUCCESS);
+        ASSERT_EQ(r.output_size, 96);
+        EXPECT_EQ(std::memcmp(&r.output_data[0], digest1.bytes, 32), 0);
+        EXPECT_EQ(std::memcmp(&r.output_data[32], digest1.bytes, 32), 0);
+        EXPECT_EQ(std::memcmp(&r.output_data[64], digest2.bytes, 32), 0);
+    }
+    EXPECT_EQ(stats.hits - hits_before, 2);
+    EXPECT_EQ(stats.misses - misses_before, 4);
+}
@@ -0,0 +1,162 @@
+// zvmone: Fast Zond Virtual Machine implementation
+// Copyright 2026 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+#include <test/utils/bytecode.hpp>
+#include <zvmc/mocked_host.hpp>
+#include <zvmone/tiering.hpp>
+#include <zvmone/vm.hpp>
+#include <zvmone/zvmone.h>
+
+using namespace zvmone;
+
+namespace
+{
+/// The fake analysis recording the analyzed code size.
+struct FakeAnalysis
+{
+    size_t code_size = 0;
+};
+
+int num_analyses = 0;
+
+FakeAnalysis counting_analyze(zvmc_revision /*rev*/, bytes_view code)
+{
+    ++num_analyses;
+    return {code.size()};
+}
+}  // namespace
+
+TEST(tiering, calls_threshold)
+{
+    num_analyses = 0;
+    Tiering<FakeAnalysis> tiering{{3, std::numeric_limits<uint64_t>::max()}};
+    const auto code = push(1) + push(2) + OP_ADD;
+
+    for (int i = 0; i < 2; ++i)
+    {
+        const auto [promoted, entry] = tiering.get(ZVMC_SHANGHAI, code, counting_analyze);
+        EXPECT_EQ(promoted, nullptr);
+        ASSERT_NE(entry, nullptr);
+        EXPECT_EQ(entry->calls, static_cast<uint64_t>(i + 1));
+    }
+    EXPECT_EQ(num_analyses, 0);
+
+    const auto p1 = tiering.get(ZVMC_SHANGHAI, code, counting_analyze);
+    ASSERT_NE(p1.promoted, nullptr);
+    EXPECT_EQ(p1.entry, nullptr);
+    EXPECT_EQ(p1.promoted->code_size, code.size());
+
+    const auto p2 = tiering.get(ZVMC_SHANGHAI, code, counting_analyze);
+    EXPECT_EQ(p2.promoted, p1.promoted);
+    EXPECT_EQ(num_analyses, 1);
+
+    const auto stats = tiering.stats();
+    EXPECT_EQ(stats.tracked, 1);
+    EXPECT_EQ(stats.promoted, 1);
+}
+
+TEST(tiering, gas_threshold)
+{
+    num_analyses = 0;
+    Tiering<FakeAnalysis> tiering{{std::numeric_limits<uint64_t>::max(), 100}};
+    const auto code = bytecode{OP_STOP};
+
+    auto lookup = tiering.get(ZVMC_SHANGHAI, code, counting_analyze);
+    ASSERT_NE(lookup.entry, nullptr);
+    tiering.add_gas_used(*lookup.entry, 60);
+
+    lookup = tiering.get(ZVMC_SHANGHAI, code, counting_analyze);
+    EXPECT_EQ(lookup.promoted, nullptr);
+    ASSERT_NE(lookup.entry, nullptr);
+    tiering.add_gas_used(*lookup.entry, 40);
+
+    EXPECT_NE(tiering.get(ZVMC_SHANGHAI, code, counting_analyze).promoted, nullptr);
+    EXPECT_EQ(num_analyses, 1);
+}
+
+TEST(tiering, capacity)
+{
+    num_analyses = 0;
+    Tiering<FakeAnalysis> tiering{{1, std::numeric_limits<uint64_t>::max()}, 1};
+
+    EXPECT_NE(tiering.get(ZVMC_SHANGHAI, push(1), counting_analyze).promoted, nullptr);
+
+    const auto untracked = tiering.get(ZVMC_SHANGHAI, push(2), counting_analyze);
+    EXPECT_EQ(untracked.promoted, nullptr);
+    EXPECT_EQ(untracked.entry, nullptr);
+    EXPECT_EQ(num_analyses, 1);
+    EXPECT_EQ(tiering.stats().tracked, 1);
+}
+
+TEST(tiering, vm_option)
+{
+    auto vm = zvmc::VM{zvmc_create_zvmone()};
+    auto& zvmone_vm = *static_cast<zvmone::VM*>(vm.get_raw_pointer());
+    EXPECT_FALSE(zvmone_vm.tiering);
+
+    EXPECT_EQ(vm.set_option("tiering", "x"), ZVMC_SET_OPTION_INVALID_VALUE);
+    EXPECT_EQ(vm.set_option("tiering", "1,"), ZVMC_SET_OPTION_INVALID_VALUE);
+    EXPECT_EQ(vm.set_option("tiering", "1,x"), ZVMC_SET_OPTION_INVALID_VALUE);
+
+    ASSERT_EQ(vm.set_option("tiering", "0,1000"), ZVMC_SET_OPTION_SUCCESS);
+    ASSERT_TRUE(zvmone_vm.tiering);
+    EXPECT_EQ(zvmone_vm.tiering->thresholds().calls, std::numeric_limits<uint64_t>::max());
+    EXPECT_EQ(zvmone_vm.tiering->thresholds().gas, 1000);
+
+    ASSERT_EQ(vm.set_option("tiering", "2"), ZVMC_SET_OPTION_SUCCESS);
+    ASSERT_TRUE(zvmone_vm.tiering);
+
+    zvmc::MockedHost host;
+    zvmc_message msg{};
+    msg.gas = 1000;
+
+    // The loop summing the numbers from 10 down to 1.
+    const auto code = push(0) + push(10) + OP_JUMPDEST + OP_DUP1 + OP_SWAP2 + OP_ADD + OP_SWAP1 +
+                      push(1) + OP_SWAP1 + OP_SUB + OP_DUP1 + push(4) + OP_JUMPI + OP_POP +
+                      ret_top();
+    int64_t gas_left = 0;
+    for (int i = 0; i < 3; ++i)
+    {
+        const auto r = vm.execute(host, ZVMC_SHANGHAI, msg, code.data(), code.size());
+        ASSERT_EQ(r.status_code, ZVMC_SUCCESS);
+        ASSERT_EQ(r.output_size, 32);
+        EXPECT_EQ(r.output_data[31], 55);
+        if (i != 0)
+            EXPECT_EQ(r.gas_left, gas_left);
+        gas_left = r.gas_left;
+    }
+    EXPECT_EQ(zvmone_vm.tiering->stats().promoted, 1);
+
+    EXPECT_EQ(vm.set_option("tiering", ""), ZVMC_SET_OPTION_SUCCESS);
+    EXPECT_FALSE(zvmone_vm.tiering);
+}
+
+#if ZVMONE_JIT_SUPPORTED
+TEST(tiering, jit_compiled_not_promoted)
+{
+    auto vm = zvmc::VM{zvmc_create_zvmone(), {{"jit", "1"}, {"tiering", "1"}}};
+    auto& zvmone_vm = *static_cast<zvmone::VM*>(vm.get_raw_pointer());
+    ASSERT_TRUE(zvmone_vm.jit_tier);
+    ASSERT_TRUE(zvmone_vm.tiering);
+
+    zvmc::MockedHost host;
+    zvmc_message msg{};
+    msg.gas = 1000;
+
+    const auto code = push(1) + push(2) + OP_ADD + ret_top();
+    for (int i = 0; i < 3; ++i)
+    {
+        const auto r = vm.execute(host, ZVMC_SHANGHAI, msg, code.data(), code.size());
+        ASSERT_EQ(r.status_code, ZVMC_SUCCESS);
+        ASSERT_EQ(r.output_size, 32);
+        EXPECT_EQ(r.output_data[31], 3);
+    }
+
+    // The JIT compiled contract stays in the JIT tier.
+    EXPECT_EQ(zvmone_vm.jit_tier->num_compiled(), 1);
+    EXPECT_EQ(zvmone_vm.tiering->stats().tracked, 0);
+    EXPECT_EQ(zvmone_vm.tiering->stats().promoted, 0);
+}
+#endif
@@ -163,6 +163,27 @@ SWAP1,1
 )");
 }
 
+TEST_F(tracing, histogram_sequences)
+{
+    vm.add_tracer(zvmone::create_histogram_tracer(trace_stream, true));
+    trace_stream << '\n';
+    const auto code = push(1) + push(6) + OP_JUMP + OP_INVALID + OP_JUMPDEST + OP_POP;
+    EXPECT_EQ(trace(code), R"(
+--- # HISTOGRAM depth=0
+opcode,count
+POP,1
+JUMP,1
+JUMPDEST,1
+PUSH1,2
+--- # SEQUENCES depth=0
+sequence,count
+JUMPDEST POP,1
+PUSH1 JUMP,1
+PUSH1 PUSH1,1
+PUSH1 PUSH1 JUMP,1
+)");
+}
+
 TEST_F(tracing, trace)
 {
     vm.add_tracer(zvmone::create_instruction_tracer(trace_stream));
@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "zvm_fixture.hpp"
+#include <zvmone/vm.hpp>
 #include <zvmone/zvmone.h>
 
 namespace zvmone::test
@@ -10,26 +11,66 @@ namespace zvmone::test
 namespace
 {
 zvmc::VM advanced_vm{zvmc_create_zvmone(), {{"advanced", ""}}};
+zvmc::VM acompact_vm{zvmc_create_zvmone(), {{"advanced", "compact"}}};
 zvmc::VM baseline_vm{zvmc_create_zvmone()};
 zvmc::VM bnocgoto_vm{zvmc_create_zvmone(), {{"cgoto", "no"}}};
+#if ZVMONE_TAILCALL_SUPPORTED
+zvmc::VM btailcall_vm{zvmc_create_zvmone(), {{"tailcall", "yes"}}};
+#endif
+zvmc::VM bblocks_vm{zvmc_create_zvmone(), {{"block_checks", "yes"}}};
+zvmc::VM bfused_vm{zvmc_create_zvmone(), {{"fusion", "yes"}}};
+zvmc::VM btiered_vm{zvmc_create_zvmone(), {{"tiering", "2"}}};
+zvmc::VM blazy_vm{zvmc_create_zvmone(), {{"lazy_jumpdests", "yes"}}};
+zvmc::VM bkeccak_vm{zvmc_create_zvmone(), {{"keccak_cache", "yes"}}};
+#if ZVMONE_JIT_SUPPORTED
+zvmc::VM bjit_vm{zvmc_create_zvmone(), {{"jit", "1"}}};
+#endif
 
 const char* print_vm_name(const testing::TestParamInfo<zvmc::VM*>& info) noexcept
 {
     if (info.param == &advanced_vm)
         return "advanced";
+    if (info.param == &acompact_vm)
+        return "acompact";
     if (info.param == &baseline_vm)
         return "baseline";
     if (info.param == &bnocgoto_vm)
         return "bnocgoto";
+#if ZVMONE_TAILCALL_SUPPORTED
+    if (info.param == &btailcall_vm)
+        return "btailcall";
+#endif
+    if (info.param == &bblocks_vm)
+        return "bblocks";
+    if (info.param == &bfused_vm)
+        return "bfused";
+    if (info.param == &btiered_vm)
+        return "btiered";
+    if (info.param == &blazy_vm)
+        return "blazy";
+    if (info.param == &bkeccak_vm)
+        return "bkeccak";
+#if ZVMONE_JIT_SUPPORTED
+    if (info.param == &bjit_vm)
+        return "bjit";
+#endif
     return "unknown";
 }
 }  // namespace
 
-INSTANTIATE_TEST_SUITE_P(
-    zvmone, zvm, testing::Values(&advanced_vm, &baseline_vm, &bnocgoto_vm), print_vm_name);
+INSTANTIATE_TEST_SUITE_P(zvmone, zvm,
+    testing::Values(&advanced_vm, &acompact_vm, &baseline_vm, &bnocgoto_vm,
+#if ZVMONE_TAILCALL_SUPPORTED
+        &btailcall_vm,
+#endif
+#if ZVMONE_JIT_SUPPORTED
+        &bjit_vm,
+#endif
+        &bblocks_vm, &bfused_vm, &btiered_vm, &blazy_vm, &bkeccak_vm),
+    print_vm_name);
 
 bool zvm::is_advanced() noexcept
 {
-    return GetParam() == &advanced_vm;
+    return GetParam() == &advanced_vm || GetParam() == &acompact_vm;
 }
 }  // namespace zvmone::test
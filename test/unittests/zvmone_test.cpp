@@ -6,6 +6,7 @@
 #include <zvmc/zvmc.hpp>
 #include <zvmone/vm.hpp>
 #include <zvmone/zvmone.h>
+#include <utility>
 
 TEST(zvmone, info)
 {
@@ -53,3 +54,52 @@ TEST(zvmone, set_option_cgoto)
     EXPECT_EQ(vm.set_option("cgoto", "no"), ZVMC_SET_OPTION_INVALID_NAME);
 #endif
 }
+
+TEST(zvmone, set_option_tailcall)
+{
+    zvmc::VM vm{zvmc_create_zvmone()};
+
+#if ZVMONE_TAILCALL_SUPPORTED
+    const auto& zvmone_vm = *static_cast<const zvmone::VM*>(vm.get_raw_pointer());
+    EXPECT_FALSE(zvmone_vm.tailcall);
+    EXPECT_EQ(vm.set_option("tailcall", "yes"), ZVMC_SET_OPTION_SUCCESS);
+    EXPECT_TRUE(zvmone_vm.tailcall);
+    EXPECT_EQ(vm.set_option("tailcall", "no"), ZVMC_SET_OPTION_SUCCESS);
+    EXPECT_FALSE(zvmone_vm.tailcall);
+    EXPECT_EQ(vm.set_option("tailcall", ""), ZVMC_SET_OPTION_INVALID_VALUE);
+#else
+    EXPECT_EQ(vm.set_option("tailcall", "yes"), ZVMC_SET_OPTION_INVALID_NAME);
+#endif
+}
+
+TEST(zvmone, set_option_bool)
+{
+    zvmc::VM vm{zvmc_create_zvmone()};
+    auto& zvmone_vm = *static_cast<zvmone::VM*>(vm.get_raw_pointer());
+
+    const std::pair<const char*, bool zvmone::VM::*> options[] = {
+        {"block_checks", &zvmone::VM::block_checks},
+        {"fusion", &zvmone::VM::fusion},
+        {"lazy_jumpdests", &zvmone::VM::lazy_jumpdests},
+        {"keccak_cache", &zvmone::VM::keccak_cache},
+    };
+    for (const auto& [name, member] : options)
+    {
+        EXPECT_FALSE(zvmone_vm.*member) << name;
+        EXPECT_EQ(vm.set_option(name, "yes"), ZVMC_SET_OPTION_SUCCESS) << name;
+        EXPECT_TRUE(zvmone_vm.*member) << name;
+        EXPECT_EQ(vm.set_option(name, ""), ZVMC_SET_OPTION_INVALID_VALUE) << name;
+        EXPECT_EQ(vm.set_option(name, "1"), ZVMC_SET_OPTION_INVALID_VALUE) << name;
+        EXPECT_TRUE(zvmone_vm.*member) << name;
+        EXPECT_EQ(vm.set_option(name, "no"), ZVMC_SET_OPTION_SUCCESS) << name;
+        EXPECT_FALSE(zvmone_vm.*member) << name;
+    }
+}
+
+TEST(zvmone, set_option_histogram)
+{
+    zvmc::VM vm{zvmc_create_zvmone()};
+    EXPECT_EQ(vm.set_option("histogram", ""), ZVMC_SET_OPTION_SUCCESS);
+    EXPECT_EQ(vm.set_option("histogram", "1"), ZVMC_SET_OPTION_SUCCESS);
+    EXPECT_EQ(vm.set_option("histogram", "sequences"), ZVMC_SET_OPTION_SUCCESS);
+}
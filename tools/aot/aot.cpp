@@ -0,0 +1,176 @@
+// zvmone: Fast Zond Virtual Machine implementation
+// Copyright 2026 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+
+/// @file
+/// The ahead-of-time compiler of the contracts: translates the contract code to the C++ source
+/// which compiled to a shared library can be loaded by zvmone with the "aot" option.
+///
+/// Usage: zvmone-aot OUTPUT_CPP CODE_HEX_FILE...
+///
+/// The output is compiled against the zvmone sources of the same version, e.g.:
+///   c++ -std=c++20 -O2 -fPIC -shared -I<zvmone>/lib -I<zvmc>/include -I<intx>/include
+///       -I<ethash>/include contracts.cpp -o contracts.so
+
+#include <zvmc/hex.hpp>
+#include <zvmone/aot.hpp>
+#include <zvmone/instructions_traits.hpp>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace zvmone;
+
+namespace
+{
+/// Returns the opcode enumerator name of the defined instruction.
+std::string opcode_name(uint8_t op)
+{
+    return std::string{"OP_"} + instr::traits[op].name;
+}
+
+/// Outputs the PUSH value as the uint256 constructor from the little-endian 64-bit words.
+void write_push_value(std::ostream& out, const uint8_t* data, size_t size)
+{
+    uint64_t words[4]{};
+    for (size_t i = 0; i < size; ++i)
+    {
+        const auto bit = (size - 1 - i) * 8;
+        words[bit / 64] |= uint64_t{data[i]} << (bit % 64);
+    }
+    out << "uint256{";
+    for (size_t i = 0; i < 4; ++i)
+        out << (i != 0 ? ", " : "") << "uint64_t{0x" << std::hex << words[i] << std::dec << "}";
+    out << "}";
+}
+
+/// Checks if the code contains JUMP or JUMPI instructions.
+bool has_jumps(bytes_view code) noexcept
+{
+    for (size_t i = 0; i < code.size(); i += 1 + size_t{instr::traits[code[i]].immediate_size})
+    {
+        if (code[i] == OP_JUMP || code[i] == OP_JUMPI)
+            return true;
+    }
+    return false;
+}
+
+/// Outputs the function executing the contract code.
+void write_contract(std::ostream& out, size_t index, bytes_view code)
+{
+    // The PUSH data may extend beyond the code end. The padding is executed as STOP.
+    auto padded_code = bytes{code};
+    padded_code.append(33, OP_STOP);
+
+    // The JUMPDEST labels are only needed if there are jumps.
+    const auto with_labels = has_jumps(code);
+    std::vector<size_t> jumpdests;
+
+    out << "constexpr uint8_t code_" << index << "[] = {";
+    for (size_t i = 0; i < code.size(); ++i)
+    {
+        out << (i % 16 == 0 ? "\n    " : " ");
+        out << "0x" << std::hex << int{code[i]} << std::dec << ",";
+    }
+    out << "\n};\n\n";
+
+    out << "int64_t contract_" << index << "(const Context& ctx, int64_t gas) noexcept\n{\n";
+    out << "    auto* stack_top = ctx.stack_bottom;\n";
+    out << "    [[maybe_unused]] code_iterator next = nullptr;\n\n";
+
+    size_t i = 0;
+    for (; i < code.size(); ++i)
+    {
+        const auto op = code[i];
+        const auto& tr = instr::traits[op];
+        if (tr.name == nullptr)
+        {
+            out << "    return undefined(ctx, gas);\n";
+            continue;
+        }
+
+        const auto name = opcode_name(op);
+        if (op == OP_JUMPDEST && with_labels)
+        {
+            out << "L" << i << ":\n";
+            jumpdests.push_back(i);
+        }
+
+        if (op >= OP_PUSH1 && op <= OP_PUSH32)
+        {
+            out << "    if (!push<" << name << ">(ctx, ";
+            write_push_value(out, &padded_code[i + 1], tr.immediate_size);
+            out << ", stack_top, gas))\n        return gas;\n";
+            i += tr.immediate_size;
+            continue;
+        }
+
+        out << "    if ((next = step<" << name << ">(ctx, " << i
+            << ", stack_top, gas)) == nullptr)\n        return gas;\n";
+        if (op == OP_JUMP)
+            out << "    goto dispatch;\n";
+        else if (op == OP_JUMPI)
+            out << "    if (next != &ctx.code[" << i + 1 << "])\n        goto dispatch;\n";
+    }
+    out << "    step<OP_STOP>(ctx, " << i << ", stack_top, gas);\n";
+    out << "    return gas;\n";
+
+    if (with_labels)
+    {
+        // The step functions only return the positions of valid jump destinations.
+        out << "\ndispatch:\n    switch (next - ctx.code)\n    {\n";
+        for (const auto dst : jumpdests)
+            out << "    case " << dst << ":\n        goto L" << dst << ";\n";
+        out << "    default:\n        return gas;\n    }\n";
+    }
+    out << "}\n\n";
+}
+}  // namespace
+
+int main(int argc, const char* argv[])
+{
+    if (argc < 3)
+    {
+        std::cerr << "Usage: " << argv[0] << " OUTPUT_CPP CODE_HEX_FILE...\n";
+        return 1;
+    }
+
+    std::vector<bytes> codes;
+    for (int i = 2; i < argc; ++i)
+    {
+        std::ifstream in{argv[i]};
+        std::stringstream hex_code;
+        hex_code << in.rdbuf();
+        auto code = zvmc::from_spaced_hex(hex_code.str());
+        if (!in || !code || code->empty())
+        {
+            std::cerr << "invalid code file: " << argv[i] << "\n";
+            return 1;
+        }
+        codes.emplace_back(std::move(*code));
+    }
+
+    std::ofstream out{argv[1]};
+    out << "// Generated by zvmone-aot.\n\n";
+    out << "#include <zvmone/aot_runtime.hpp>\n#include <iterator>\n\n";
+    out << "namespace\n{\nusing namespace zvmone;\nusing namespace zvmone::aot;\n\n";
+    for (size_t i = 0; i < codes.size(); ++i)
+        write_contract(out, i, codes[i]);
+
+    out << "constexpr Contract contracts[] = {\n";
+    for (size_t i = 0; i < codes.size(); ++i)
+        out << "    {code_" << i << ", sizeof(code_" << i << "), contract_" << i << "},\n";
+    out << "};\n}  // namespace\n\n";
+    out << "extern \"C\" __attribute__((visibility(\"default\"))) const zvmone::aot::Library "
+        << aot::library_symbol
+        << "{zvmone::aot::abi_version, std::size(contracts), contracts};\n";
+
+    if (!out)
+    {
+        std::cerr << "cannot write " << argv[1] << "\n";
+        return 1;
+    }
+    return 0;
+}